@@ -33,6 +33,7 @@ void NeoSTAND::Initialize(const PluginMetadata &metadata, CoreAPI *coreAPI, Clie
     logger_ = &lcoreAPI->logger();
     tagInterface_ = lcoreAPI->tag().getInterface();
 	dataManager_ = std::make_unique<DataManager>(this);
+	dataManager_->PopulateActiveAirports(); // starts loading configs of airports already active
 
 #ifndef DEV
 	std::pair<bool, std::string> updateAvailable = newVersionAvailable();
@@ -136,16 +137,18 @@ void NeoSTAND::runScopeUpdate() {
     if (!dataManager_) return;
 	dataManager_->updateAllPilots();
 
-	std::vector<DataManager::Pilot> pilots = dataManager_->getAllPilots();
+	// Every arrival still without stand is assigned in one batch per airport
+	dataManager_->assignPendingStands();
+
+	std::vector<InternId> callsigns = dataManager_->getAllPilotCallsigns();
 	
-    for (auto& pilot : pilots) {
-        if (pilot.stand.empty()) dataManager_->assignStands(pilot);
-        this->UpdateTagItems(pilot.callsign);
+    for (InternId callsign : callsigns) {
+        this->UpdateTagItems(str(callsign));
 	}
 }
 
 void NeoSTAND::OnTimer(int Counter) {
-    if (Counter % 5 == 0 && autoMode) this->runScopeUpdate();
+    if (Counter % UPDATE_INTERVAL == 0 && autoMode) this->runScopeUpdate();
 }
 
 void stand::NeoSTAND::OnAirportConfigurationsUpdated(const Airport::AirportConfigurationsUpdatedEvent* event)
@@ -185,15 +188,17 @@ void stand::NeoSTAND::OnAircraftDisconnected(const Aircraft::AircraftDisconnecte
 }
 
 void NeoSTAND::UpdateTagItems(std::string callsign) {
-	dataManager_->updatePilot(callsign);
-    DataManager::Pilot pilot = dataManager_->getPilotByCallsign(callsign);
-    if (pilot.empty()) return;
+	DataManager::PilotHandle pilot = dataManager_->updatePilot(callsign);
+    if (!pilot) return;
+
+    InternId standName = NO_INTERN_ID;
+    if (!dataManager_->withPilot(pilot, [&standName](const DataManager::Pilot& p) { standName = p.stand; })) return;
 
     Tag::TagContext tagContext;
     tagContext.callsign = callsign;
     tagContext.colour = ColorizeStand();
 
-	std::string stand = pilot.stand.empty() ? "N/A" : pilot.stand;
+	std::string stand = (standName == NO_INTERN_ID) ? "N/A" : str(standName);
 
     updateTagValueIfChanged(callsign, standItemId_, stand, tagContext);
 }
@@ -71,6 +71,9 @@ namespace stand {
 		std::string airportsCommandId_;
         std::string occupiedCommandId_;
         std::string blockedCommandId_;
+        std::string cacheCommandId_;
+        std::string freeCommandId_;
+        std::string seedCommandId_;
 
 
     private:
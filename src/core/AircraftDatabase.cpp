@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <array>
+
+#include "AircraftDatabase.h"
+
+namespace stand
+{
+	namespace
+	{
+		constexpr AircraftPerformance entry(std::string_view type, uint16_t wingspan, uint16_t length, EngineType engine)
+		{
+			return { aircraftTypeKey(type), wingspan, length, engine, codeForWingspan(wingspan) };
+		}
+
+		// Common types seen on the network, wingspan and length in decimetres
+		constexpr const std::array AIRCRAFT = {
+			entry("A124", 733, 691, EngineType::jet),
+			entry("A19N", 358, 338, EngineType::jet),
+			entry("A20N", 358, 376, EngineType::jet),
+			entry("A21N", 358, 445, EngineType::jet),
+			entry("A306", 448, 541, EngineType::jet),
+			entry("A310", 439, 467, EngineType::jet),
+			entry("A318", 341, 314, EngineType::jet),
+			entry("A319", 358, 338, EngineType::jet),
+			entry("A320", 358, 376, EngineType::jet),
+			entry("A321", 358, 445, EngineType::jet),
+			entry("A332", 603, 588, EngineType::jet),
+			entry("A333", 603, 637, EngineType::jet),
+			entry("A338", 640, 588, EngineType::jet),
+			entry("A339", 640, 637, EngineType::jet),
+			entry("A342", 603, 594, EngineType::jet),
+			entry("A343", 603, 637, EngineType::jet),
+			entry("A345", 635, 679, EngineType::jet),
+			entry("A346", 635, 754, EngineType::jet),
+			entry("A359", 648, 668, EngineType::jet),
+			entry("A35K", 648, 738, EngineType::jet),
+			entry("A388", 798, 727, EngineType::jet),
+			entry("A400", 424, 451, EngineType::turboprop),
+			entry("AT43", 246, 227, EngineType::turboprop),
+			entry("AT45", 246, 227, EngineType::turboprop),
+			entry("AT46", 246, 227, EngineType::turboprop),
+			entry("AT72", 271, 272, EngineType::turboprop),
+			entry("AT75", 271, 272, EngineType::turboprop),
+			entry("AT76", 271, 272, EngineType::turboprop),
+			entry("B190", 177, 176, EngineType::turboprop),
+			entry("B350", 177, 142, EngineType::turboprop),
+			entry("B37M", 359, 356, EngineType::jet),
+			entry("B38M", 359, 395, EngineType::jet),
+			entry("B39M", 359, 422, EngineType::jet),
+			entry("B3XM", 359, 438, EngineType::jet),
+			entry("B463", 263, 310, EngineType::jet),
+			entry("B712", 284, 378, EngineType::jet),
+			entry("B733", 289, 334, EngineType::jet),
+			entry("B734", 289, 364, EngineType::jet),
+			entry("B735", 289, 310, EngineType::jet),
+			entry("B736", 343, 312, EngineType::jet),
+			entry("B737", 343, 336, EngineType::jet),
+			entry("B738", 343, 395, EngineType::jet),
+			entry("B739", 343, 421, EngineType::jet),
+			entry("B744", 644, 707, EngineType::jet),
+			entry("B748", 684, 763, EngineType::jet),
+			entry("B752", 381, 473, EngineType::jet),
+			entry("B753", 381, 544, EngineType::jet),
+			entry("B762", 476, 485, EngineType::jet),
+			entry("B763", 476, 549, EngineType::jet),
+			entry("B764", 519, 614, EngineType::jet),
+			entry("B772", 609, 637, EngineType::jet),
+			entry("B773", 609, 739, EngineType::jet),
+			entry("B778", 648, 709, EngineType::jet),
+			entry("B779", 648, 767, EngineType::jet),
+			entry("B77L", 648, 637, EngineType::jet),
+			entry("B77W", 648, 739, EngineType::jet),
+			entry("B788", 601, 567, EngineType::jet),
+			entry("B789", 601, 628, EngineType::jet),
+			entry("B78X", 601, 683, EngineType::jet),
+			entry("BCS1", 351, 350, EngineType::jet),
+			entry("BCS3", 351, 387, EngineType::jet),
+			entry("BE20", 166, 134, EngineType::turboprop),
+			entry("C130", 404, 298, EngineType::turboprop),
+			entry("C152", 101, 73, EngineType::piston),
+			entry("C17", 518, 530, EngineType::jet),
+			entry("C172", 110, 83, EngineType::piston),
+			entry("C182", 110, 88, EngineType::piston),
+			entry("C208", 159, 115, EngineType::turboprop),
+			entry("C25A", 144, 140, EngineType::jet),
+			entry("C56X", 172, 158, EngineType::jet),
+			entry("C68A", 220, 190, EngineType::jet),
+			entry("CL35", 195, 209, EngineType::jet),
+			entry("CL60", 196, 209, EngineType::jet),
+			entry("CRJ2", 212, 268, EngineType::jet),
+			entry("CRJ7", 232, 325, EngineType::jet),
+			entry("CRJ9", 249, 362, EngineType::jet),
+			entry("CRJX", 262, 391, EngineType::jet),
+			entry("D328", 210, 213, EngineType::turboprop),
+			entry("DA40", 119, 80, EngineType::piston),
+			entry("DA42", 134, 86, EngineType::piston),
+			entry("DC10", 504, 555, EngineType::jet),
+			entry("DH8A", 259, 223, EngineType::turboprop),
+			entry("DH8C", 274, 257, EngineType::turboprop),
+			entry("DH8D", 284, 328, EngineType::turboprop),
+			entry("E170", 260, 299, EngineType::jet),
+			entry("E175", 260, 317, EngineType::jet),
+			entry("E190", 287, 362, EngineType::jet),
+			entry("E195", 287, 387, EngineType::jet),
+			entry("E290", 337, 362, EngineType::jet),
+			entry("E295", 351, 415, EngineType::jet),
+			entry("E50P", 123, 128, EngineType::jet),
+			entry("E55P", 162, 156, EngineType::jet),
+			entry("EC35", 102, 122, EngineType::turboshaft),
+			entry("EC45", 110, 130, EngineType::turboshaft),
+			entry("F100", 281, 355, EngineType::jet),
+			entry("F2TH", 193, 202, EngineType::jet),
+			entry("F70", 281, 309, EngineType::jet),
+			entry("F900", 193, 202, EngineType::jet),
+			entry("FA7X", 262, 232, EngineType::jet),
+			entry("FA8X", 263, 245, EngineType::jet),
+			entry("GLEX", 287, 303, EngineType::jet),
+			entry("GLF5", 285, 294, EngineType::jet),
+			entry("GLF6", 304, 304, EngineType::jet),
+			entry("H145", 110, 136, EngineType::turboshaft),
+			entry("IL76", 505, 466, EngineType::jet),
+			entry("J328", 210, 212, EngineType::jet),
+			entry("JS41", 183, 193, EngineType::turboprop),
+			entry("LJ45", 146, 177, EngineType::jet),
+			entry("MD11", 517, 616, EngineType::jet),
+			entry("MD82", 329, 451, EngineType::jet),
+			entry("MD83", 329, 451, EngineType::jet),
+			entry("MD88", 329, 451, EngineType::jet),
+			entry("MD90", 329, 465, EngineType::jet),
+			entry("P28A", 107, 73, EngineType::piston),
+			entry("PA28", 107, 73, EngineType::piston),
+			entry("PA34", 119, 87, EngineType::piston),
+			entry("PC12", 163, 144, EngineType::turboprop),
+			entry("RJ1H", 263, 310, EngineType::jet),
+			entry("RJ85", 263, 286, EngineType::jet),
+			entry("SB20", 248, 273, EngineType::turboprop),
+			entry("SF34", 214, 197, EngineType::turboprop),
+			entry("SR22", 117, 79, EngineType::piston),
+			entry("TBM8", 128, 107, EngineType::turboprop),
+			entry("TBM9", 128, 107, EngineType::turboprop),
+		};
+
+		static_assert(std::is_sorted(AIRCRAFT.begin(), AIRCRAFT.end(),
+			[](const AircraftPerformance& a, const AircraftPerformance& b) { return a.key < b.key; }),
+			"aircraft table must stay sorted by key");
+	}
+
+	std::optional<AircraftPerformance> findAircraft(std::string_view type)
+	{
+		const uint32_t key = aircraftTypeKey(type);
+		if (key == 0) return std::nullopt;
+
+		auto it = std::lower_bound(AIRCRAFT.begin(), AIRCRAFT.end(), key,
+			[](const AircraftPerformance& entry, uint32_t value) { return entry.key < value; });
+		if (it == AIRCRAFT.end() || it->key != key) return std::nullopt;
+		return *it;
+	}
+
+	size_t aircraftDatabaseSize()
+	{
+		return AIRCRAFT.size();
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "StandTable.h"
+
+namespace stand
+{
+	enum class EngineType : uint8_t
+	{
+		unknown = 0,
+		piston,
+		turboprop,
+		turboshaft,
+		jet
+	};
+
+	// Static performance data of an ICAO aircraft type designator
+	struct AircraftPerformance
+	{
+		uint32_t key;      // aircraftTypeKey() of the designator
+		uint16_t wingspan; // decimetres
+		uint16_t length;   // decimetres
+		EngineType engine;
+		StandCode code;    // ICAO aerodrome reference code letter, from the wingspan
+	};
+
+	// Up to 4 designator characters packed into an integer, 0 when invalid. Case-insensitive.
+	constexpr uint32_t aircraftTypeKey(std::string_view type)
+	{
+		if (type.empty() || type.size() > 4) return 0;
+		uint32_t key = 0;
+		for (size_t i = 0; i < 4; ++i) {
+			char c = i < type.size() ? type[i] : '\0';
+			if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+			if (c != '\0' && !((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))) return 0;
+			key = (key << 8) | static_cast<uint8_t>(c);
+		}
+		return key;
+	}
+
+	// ICAO Annex 14 code letter by wingspan: A < 15 m, B < 24 m, C < 36 m, D < 52 m, E < 65 m, F < 80 m
+	constexpr StandCode codeForWingspan(uint16_t wingspan)
+	{
+		if (wingspan < 150) return StandCode::A;
+		if (wingspan < 240) return StandCode::B;
+		if (wingspan < 360) return StandCode::C;
+		if (wingspan < 520) return StandCode::D;
+		if (wingspan < 650) return StandCode::E;
+		return StandCode::F;
+	}
+
+	// Compiled-in, read-only table sorted by key, binary searched. No allocation.
+	std::optional<AircraftPerformance> findAircraft(std::string_view type);
+	size_t aircraftDatabaseSize();
+}
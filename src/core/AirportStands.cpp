@@ -0,0 +1,131 @@
+#include <algorithm>
+
+#include "AirportStands.h"
+
+namespace stand
+{
+	std::vector<InternId> AirportStands::follow(const StandTable& table)
+	{
+		// Stand ids may have moved in the new table, blocks follow the new BLOCK lists
+		std::vector<InternId> dropped;
+		for (auto it = stays_.begin(); it != stays_.end();) {
+			std::optional<StandId> id = table.find(str(it->second.name));
+			if (!id) {
+				dropped.push_back(it->first);
+				it = stays_.erase(it);
+				continue;
+			}
+			it->second.id = *id;
+			++it;
+		}
+
+		occupancy_.reset(table);
+		timeline_.reset(table.size());
+		for (const auto& [callsign, stay] : stays_) {
+			occupancy_.hold(stay.id);
+			reserve(callsign, stay);
+		}
+		return dropped;
+	}
+
+	void AirportStands::clear()
+	{
+		stays_.clear();
+		occupancy_ = StandOccupancy{};
+		timeline_ = StandTimeline{};
+	}
+
+	StandBitset AirportStands::releasedDuring(TimePoint from, TimePoint until) const
+	{
+		StandBitset released(occupancy_.size());
+		if (timeline_.size() != occupancy_.size()) return released;
+
+		StandBitset held = occupancy_.occupied();
+		for (size_t w = 0; w < held.wordCount(); ++w) {
+			held.data()[w] |= occupancy_.blocked().data()[w];
+		}
+		timeline_.freeDuring(held, from, until, released);
+		return released;
+	}
+
+	std::optional<StandId> AirportStands::select(const StandTable& table, const StandRequest& request, TimePoint eta, const uint32_t* taxi,
+		size_t* rung)
+	{
+		// Best priority level first, random among the matching stands of that level
+		const StandBitset released = releasedDuring(eta, eta + turnaroundFor(request.code));
+		const CandidateProfile& profile = candidates_.profile(table, request);
+		return occupancy_.selectBest(table.index, profile, random_.next(), &released, rung, taxi);
+	}
+
+	std::vector<std::optional<StandId>> AirportStands::match(const StandTable& table, const std::vector<StandRequest>& requests,
+		const std::vector<TimePoint>& etas, const uint32_t* taxi)
+	{
+		std::vector<StandBitset> released;
+		released.reserve(requests.size());
+		for (size_t i = 0; i < requests.size(); ++i) released.push_back(releasedDuring(etas[i], etas[i] + turnaroundFor(requests[i].code)));
+		return matchStands(table, occupancy_, requests, &released, &candidates_, taxi);
+	}
+
+	bool AirportStands::fits(StandId id, TimePoint eta, StandCode code) const
+	{
+		return id < timeline_.size() && timeline_.isFree(id, eta, eta + turnaroundFor(code));
+	}
+
+	void AirportStands::reserve(InternId callsign, const StandStay& stay)
+	{
+		timeline_.reserve(stay.id, stay.from, stay.until, callsign);
+		for (StandId blocked : occupancy_.blocks(stay.id)) timeline_.reserve(blocked, stay.from, stay.until, callsign);
+	}
+
+	void AirportStands::hold(InternId callsign, InternId name, StandId id, TimePoint from, TimePoint until)
+	{
+		release(callsign);
+		const StandStay& stay = stays_[callsign] = StandStay{ name, id, from, until };
+		occupancy_.hold(id);
+		reserve(callsign, stay);
+	}
+
+	bool AirportStands::release(InternId callsign)
+	{
+		auto stay = stays_.find(callsign);
+		if (stay == stays_.end()) return false;
+
+		// Reference counts keep stands another pilot still holds or blocks
+		const StandId id = stay->second.id;
+		if (id < occupancy_.size()) {
+			occupancy_.unhold(id);
+			if (timeline_.size() == occupancy_.size()) {
+				timeline_.release(id, callsign);
+				for (StandId blocked : occupancy_.blocks(id)) timeline_.release(blocked, callsign);
+			}
+		}
+		stays_.erase(stay);
+		return true;
+	}
+
+	void AirportStands::collectLater(StandId id, TimePoint from, TimePoint until, std::vector<InternId>& displaced) const
+	{
+		if (!timeline_.isFree(id, from, until)) timeline_.holdersStarting(id, from, until, displaced);
+	}
+
+	std::vector<InternId> AirportStands::extendStays(TimePoint until)
+	{
+		std::vector<InternId> displaced;
+		for (auto& [callsign, stay] : stays_) {
+			if (stay.until >= until) continue;
+			if (stay.id < timeline_.size() && timeline_.size() == occupancy_.size()) {
+				// The stay only grows past its own reservation, whatever starts in the extension was given to someone later
+				collectLater(stay.id, stay.until, until, displaced);
+				for (StandId blocked : occupancy_.blocks(stay.id)) collectLater(blocked, stay.until, until, displaced);
+				timeline_.extend(stay.id, callsign, until);
+				for (StandId blocked : occupancy_.blocks(stay.id)) timeline_.extend(blocked, callsign, until);
+			}
+			stay.until = until;
+		}
+
+		std::sort(displaced.begin(), displaced.end());
+		displaced.erase(std::unique(displaced.begin(), displaced.end()), displaced.end());
+		for (InternId callsign : displaced) release(callsign);
+		return displaced;
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "CandidateCache.h"
+#include "StandMatcher.h"
+#include "StandOccupancy.h"
+#include "StandRandom.h"
+#include "StandTable.h"
+#include "StandTimeline.h"
+#include "utils/InternPool.h"
+
+namespace stand
+{
+	// A stand held by a pilot and the window it is reserved for, the stands of its BLOCK list are reserved for the same window
+	struct StandStay
+	{
+		InternId name = NO_INTERN_ID;
+		StandId id = 0; // in the table given to the last follow()
+		TimePoint from = 0;
+		TimePoint until = 0;
+	};
+
+	// Live stand state of one airport: the stays by pilot callsign, the occupancy and timeline
+	// mirroring them, and the candidate cache and generator the selection draws from.
+	// Kept free of the SDK so a traffic sequence can be played against it directly.
+	// Not thread safe, DataManager keeps one per airport under dataMutex_.
+	class AirportStands
+	{
+	public:
+		// StandIndex::epoch of the table the stays are mapped to, follow() a table of another epoch before using it
+		uint64_t tableEpoch() const { return occupancy_.tableEpoch(); }
+		// Remaps the stays to the table's StandIds by name and rebuilds occupancy and timeline from them.
+		// Returns the callsigns whose stand the table no longer has, their stays are dropped.
+		std::vector<InternId> follow(const StandTable& table);
+
+		// Restarts the tie-break sequence
+		void reseed(uint64_t seed) { random_.reseed(seed); }
+		// Drops every stay, the candidate cache and the tie-break sequence carry on
+		void clear();
+
+		// Best stand for a pilot on stand from eta, see StandOccupancy::selectBest. Draws from the tie-break sequence.
+		std::optional<StandId> select(const StandTable& table, const StandRequest& request, TimePoint eta, const uint32_t* taxi = nullptr,
+			size_t* rung = nullptr);
+		// One stand per pilot of a batch, see matchStands. etas is parallel to requests.
+		// The pick of one pilot may block another's, check fits() before each hold().
+		std::vector<std::optional<StandId>> match(const StandTable& table, const std::vector<StandRequest>& requests,
+			const std::vector<TimePoint>& etas, const uint32_t* taxi = nullptr);
+		// Whether the stand has no reservation overlapping a stay of an aircraft of code from eta
+		bool fits(StandId id, TimePoint eta, StandCode code) const;
+
+		// Gives the stand to callsign for [from, until), replacing the stay it had
+		void hold(InternId callsign, InternId name, StandId id, TimePoint from, TimePoint until);
+		// Drops callsign's stay and the blocks it holds, O(BLOCK degree). False when it had none.
+		bool release(InternId callsign);
+		// Pushes every stay ending before until to until. A stay running into the reservation of a later
+		// arrival keeps its stand: those arrivals are released and returned, they need another one.
+		std::vector<InternId> extendStays(TimePoint until);
+
+		const std::unordered_map<InternId, StandStay>& stays() const { return stays_; }
+		const StandOccupancy& occupancy() const { return occupancy_; }
+		const StandTimeline& timeline() const { return timeline_; }
+
+	private:
+		// The held stands (occupied or blocked) free for the whole of [from, until)
+		StandBitset releasedDuring(TimePoint from, TimePoint until) const;
+		void reserve(InternId callsign, const StandStay& stay);
+		// Appends to displaced the later arrivals reserved on id during [from, until)
+		void collectLater(StandId id, TimePoint from, TimePoint until, std::vector<InternId>& displaced) const;
+
+		std::unordered_map<InternId, StandStay> stays_; // by pilot callsign
+		StandOccupancy occupancy_;
+		StandTimeline timeline_;
+		CandidateCache candidates_;
+		StandRandom random_;
+	};
+}
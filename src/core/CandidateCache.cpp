@@ -0,0 +1,89 @@
+#include "CandidateCache.h"
+
+namespace stand
+{
+	const CandidateProfile& CandidateCache::profile(const StandTable& table, const StandRequest& request)
+	{
+		const StandIndex& index = table.index;
+		if (epoch_ != index.epoch) {
+			profiles_.clear();
+			epoch_ = index.epoch;
+		}
+
+		auto [it, inserted] = profiles_.try_emplace(profileKey(request, !table.rules.empty()));
+		CandidateProfile& profile = it->second;
+		if (!inserted) {
+			++hits_;
+			return profile;
+		}
+		++misses_;
+
+		// Stands whose RULES this pilot fails, evaluated once for the profile
+		StandBitset allowed = index.all;
+		table.rules.apply(request, allowed);
+		auto restrict = [&allowed](StandBitset& bitmap) {
+			for (size_t w = 0; w < bitmap.wordCount(); ++w) {
+				bitmap.data()[w] &= allowed.data()[w];
+			}
+		};
+
+		index.attributes(request, profile.attributes);
+		restrict(profile.attributes);
+		auto airline = (request.airline != 0) ? index.byAirline.find(request.airline) : index.byAirline.end();
+		if (airline != index.byAirline.end()) {
+			profile.preferred = profile.attributes;
+			for (size_t w = 0; w < profile.preferred.wordCount(); ++w) {
+				profile.preferred.data()[w] &= airline->second.data()[w];
+			}
+			profile.hasAirline = profile.preferred.any();
+		}
+
+		uint32_t relaxed = 0;
+		profile.relaxed.resize(index.relaxations.size());
+		for (size_t rung = 0; rung < index.relaxations.size(); ++rung) {
+			relaxed |= 1u << static_cast<uint32_t>(index.relaxations[rung]);
+			index.attributes(request, profile.relaxed[rung], relaxed);
+			restrict(profile.relaxed[rung]);
+		}
+		return profile;
+	}
+
+	void CandidateCache::clear()
+	{
+		profiles_.clear();
+		epoch_ = 0;
+	}
+
+	CandidateCache::ProfileKey CandidateCache::profileKey(const StandRequest& request, bool withType)
+	{
+		// 3 bits per enum, 1 per flag, the 24 bit airline key on top
+		return ProfileKey{ static_cast<uint64_t>(request.use)
+			| static_cast<uint64_t>(request.wtc) << 3
+			| static_cast<uint64_t>(request.code) << 6
+			| static_cast<uint64_t>(request.schengen) << 9
+			| static_cast<uint64_t>(request.national) << 10
+			| static_cast<uint64_t>(request.airline) << 16,
+			withType ? request.aircraftType : 0 };
+	}
+
+	bool liveCandidates(const StandIndex& index, const CandidateProfile& profile, const StandBitset& occupied, const StandBitset& blocked,
+		StandBitset& out, const StandBitset* released)
+	{
+		if (profile.hasAirline) {
+			index.candidates(profile.preferred, occupied, blocked, out, released);
+			if (out.any()) return true;
+		}
+		index.candidates(profile.attributes, occupied, blocked, out, released);
+		return false;
+	}
+
+	size_t relaxedCandidates(const StandIndex& index, const CandidateProfile& profile, const StandBitset& occupied, const StandBitset& blocked,
+		StandBitset& out, const StandBitset* released)
+	{
+		for (size_t rung = 0; rung < profile.relaxed.size(); ++rung) {
+			index.candidates(profile.relaxed[rung], occupied, blocked, out, released);
+			if (out.any()) return rung + 1;
+		}
+		return 0;
+	}
+}
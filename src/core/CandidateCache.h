@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "StandIndex.h"
+#include "StandTable.h"
+
+namespace stand
+{
+	// Occupancy independent part of a pilot's candidate set
+	struct CandidateProfile
+	{
+		StandBitset attributes; // StandIndex::attributes() of the request, minus stands whose RULES it fails
+		StandBitset preferred;  // attributes & stands listing the airline, empty when there is none
+		bool hasAirline = false;
+		// relaxed[i] = attributes with rungs 0..i of the airport's relaxation ladder ignored
+		std::vector<StandBitset> relaxed;
+	};
+
+	// Memoised CandidateProfiles of one airport, keyed by everything in a StandRequest
+	// (the aircraft type only when the airport has RULES).
+	// Most arrivals share a profile (same airline, use, WTC, code, flags), so the CALLSIGN
+	// and attribute filtering happens once per profile and config instead of once per pilot.
+	// Not thread safe, DataManager keeps one per airport under dataMutex_.
+	class CandidateCache
+	{
+	public:
+		// Profile for the request, built on first use. Every entry is dropped first
+		// when index comes from another config than the cached ones (StandIndex::epoch).
+		// The reference stays valid until the next epoch change or clear().
+		const CandidateProfile& profile(const StandTable& table, const StandRequest& request);
+
+		void clear();
+		size_t size() const { return profiles_.size(); }
+		uint64_t hits() const { return hits_; }
+		uint64_t misses() const { return misses_; }
+
+		struct ProfileKey
+		{
+			uint64_t attributes; // use, WTC, code, flags and airline
+			uint32_t aircraftType;
+			bool operator==(const ProfileKey&) const = default;
+		};
+		static ProfileKey profileKey(const StandRequest& request, bool withType);
+
+	private:
+		struct ProfileKeyHash
+		{
+			size_t operator()(const ProfileKey& key) const
+			{
+				return std::hash<uint64_t>{}(key.attributes ^ (static_cast<uint64_t>(key.aircraftType) * 0x9E3779B97F4A7C15ull));
+			}
+		};
+
+		uint64_t epoch_ = 0;
+		std::unordered_map<ProfileKey, CandidateProfile, ProfileKeyHash> profiles_;
+		uint64_t hits_ = 0;
+		uint64_t misses_ = 0;
+	};
+
+	// out = the profile's stands that are free now, or in released; narrowed to the airline's
+	// stands when one of them is, same as StandIndex::candidates followed by preferAirline.
+	// Returns whether the airline narrowing applied.
+	bool liveCandidates(const StandIndex& index, const CandidateProfile& profile, const StandBitset& occupied, const StandBitset& blocked,
+		StandBitset& out, const StandBitset* released = nullptr);
+
+	// For a pilot without live candidate: out = the free stands of the first relaxation rung that has any,
+	// one AND pass per rung. Returns that rung's 1 based position on the ladder, 0 when none has.
+	size_t relaxedCandidates(const StandIndex& index, const CandidateProfile& profile, const StandBitset& occupied, const StandBitset& blocked,
+		StandBitset& out, const StandBitset* released = nullptr);
+}
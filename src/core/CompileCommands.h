@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cstdlib>
 #include <string>
 
 #include "NeoSTAND.h"
@@ -52,6 +53,33 @@ void NeoSTAND::RegisterCommand() {
         definition.parameters.clear();
 
         blockedCommandId_ = chatAPI_->registerCommand(definition.name, definition, CommandProvider_);
+
+        definition.name = "stand cache";
+        definition.description = "Display config cache statistics";
+        definition.lastParameterHasSpaces = false;
+        definition.parameters.clear();
+
+        cacheCommandId_ = chatAPI_->registerCommand(definition.name, definition, CommandProvider_);
+
+        definition.name = "stand free";
+        definition.description = "Display free stands per priority";
+        definition.lastParameterHasSpaces = false;
+        definition.parameters.clear();
+
+        freeCommandId_ = chatAPI_->registerCommand(definition.name, definition, CommandProvider_);
+
+        definition.name = "stand seed";
+        definition.description = "Display or set the stand selection seed";
+        definition.lastParameterHasSpaces = false;
+        definition.parameters.clear();
+
+        PluginSDK::Chat::CommandParameter seedParameter;
+        seedParameter.name = "value";
+        seedParameter.type = PluginSDK::Chat::ParameterType::String; // parsed as an unsigned 64 bit integer by the handler
+        seedParameter.required = false;
+        definition.parameters.push_back(seedParameter);
+
+        seedCommandId_ = chatAPI_->registerCommand(definition.name, definition, CommandProvider_);
     }
     catch (const std::exception& ex)
     {
@@ -69,6 +97,9 @@ inline void NeoSTAND::unegisterCommand()
         chatAPI_->unregisterCommand(airportsCommandId_);
 		chatAPI_->unregisterCommand(occupiedCommandId_);
 		chatAPI_->unregisterCommand(blockedCommandId_);
+		chatAPI_->unregisterCommand(cacheCommandId_);
+		chatAPI_->unregisterCommand(freeCommandId_);
+		chatAPI_->unregisterCommand(seedCommandId_);
         CommandProvider_.reset();
 	}
 }
@@ -89,6 +120,9 @@ Chat::CommandResult NeoSTANDCommandProvider::Execute( const std::string &command
 		  ".stand airports",
 		  ".stand occupied",
 		  ".stand blocked",
+		  ".stand cache",
+		  ".stand free",
+		  ".stand seed [value]",
             })
         {
             neoSTAND_->DisplayMessage(line);
@@ -151,6 +185,52 @@ Chat::CommandResult NeoSTANDCommandProvider::Execute( const std::string &command
         }
         return { true, std::nullopt };
 	}
+    else if (commandId == neoSTAND_->cacheCommandId_)
+    {
+        DataManager::ConfigCacheStats stats = neoSTAND_->GetDataManager()->getConfigCacheStats();
+        neoSTAND_->DisplayMessage("Config cache: " + std::to_string(stats.hits) + " hits, " + std::to_string(stats.misses) + " misses");
+        if (stats.airports.empty()) {
+            neoSTAND_->DisplayMessage("No airport config cached.");
+        }
+        else {
+            std::string line = "Cached airports:";
+            for (const std::string& icao : stats.airports) line += " " + icao;
+            neoSTAND_->DisplayMessage(line);
+        }
+        for (const auto& [icao, microseconds] : stats.readyTimes) {
+            neoSTAND_->DisplayMessage(icao + " config " + (microseconds ? "ready " + std::to_string(*microseconds) + " us after activation" : std::string("loading")));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return { true, std::nullopt };
+    }
+    else if (commandId == neoSTAND_->freeCommandId_)
+    {
+        std::vector<std::string> lines = neoSTAND_->GetDataManager()->getFreeStandCounts();
+        if (lines.empty()) {
+            neoSTAND_->DisplayMessage("No active airports found.");
+        }
+        else {
+            lines.emplace(lines.begin(), "Free stands per priority (free/total):");
+            for (const std::string& line : lines)
+            {
+                neoSTAND_->DisplayMessage(line);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        return { true, std::nullopt };
+    }
+    else if (commandId == neoSTAND_->seedCommandId_)
+    {
+        if (args.size() > 1) return { false, "Usage: .stand seed [value]" };
+        if (args.size() == 1) {
+            char* end = nullptr;
+            const uint64_t seed = std::strtoull(args[0].c_str(), &end, 10);
+            if (args[0].empty() || *end != '\0') return { false, "Invalid seed: " + args[0] };
+            neoSTAND_->GetDataManager()->setSeed(seed);
+        }
+        neoSTAND_->DisplayMessage("Stand selection seed: " + std::to_string(neoSTAND_->GetDataManager()->getSeed()));
+        return { true, std::nullopt };
+    }
     else {
         return { false, "error" };
     }
@@ -0,0 +1,137 @@
+#include <chrono>
+#include <set>
+
+#include "ConfigWatcher.h"
+#include "StandBundle.h"
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace stand
+{
+	namespace
+	{
+		constexpr const auto POLL_INTERVAL = std::chrono::seconds(2);
+		constexpr const int INOTIFY_TIMEOUT_MS = 500; // how often the inotify loop checks for stop()
+	}
+
+	ConfigWatcher::ConfigWatcher(std::filesystem::path directory, Callback callback)
+		: directory_(std::move(directory)), callback_(std::move(callback)) {
+	}
+
+	ConfigWatcher::~ConfigWatcher()
+	{
+		stop();
+	}
+
+	void ConfigWatcher::start()
+	{
+		if (worker_.joinable()) return;
+		stop_ = false;
+		worker_ = std::thread(&ConfigWatcher::run, this);
+	}
+
+	void ConfigWatcher::stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(stopMutex_);
+			stop_ = true;
+		}
+		stopCv_.notify_all();
+		if (worker_.joinable()) worker_.join();
+	}
+
+	bool ConfigWatcher::isConfigFile(const std::filesystem::path& path) const
+	{
+		return path.extension() == ".json" || path.filename() == bundle::FILE_NAME;
+	}
+
+	void ConfigWatcher::run()
+	{
+		if (!runInotify()) runPolling();
+	}
+
+	bool ConfigWatcher::runInotify()
+	{
+#if defined(__linux__)
+		int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (fd < 0) return false;
+
+		int wd = inotify_add_watch(fd, directory_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+		if (wd < 0) {
+			::close(fd);
+			return false;
+		}
+		usingInotify_ = true;
+
+		alignas(inotify_event) char buffer[4096];
+		while (!stop_) {
+			pollfd pfd{ fd, POLLIN, 0 };
+			if (::poll(&pfd, 1, INOTIFY_TIMEOUT_MS) <= 0) continue;
+
+			// Coalesce the burst of events an editor save produces into one callback per airport
+			std::set<std::string> changed;
+			ssize_t length;
+			while ((length = ::read(fd, buffer, sizeof(buffer))) > 0) {
+				for (char* ptr = buffer; ptr < buffer + length; ) {
+					const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+					if (event->len > 0) {
+						std::filesystem::path file(event->name);
+						if (isConfigFile(file)) changed.insert(file.stem().string());
+					}
+					ptr += sizeof(inotify_event) + event->len;
+				}
+			}
+
+			for (const auto& icao : changed) {
+				if (stop_) break;
+				callback_(icao);
+			}
+		}
+
+		inotify_rm_watch(fd, wd);
+		::close(fd);
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void ConfigWatcher::runPolling()
+	{
+		usingInotify_ = false;
+		scanDirectory(false);
+
+		std::unique_lock<std::mutex> lock(stopMutex_);
+		while (!stop_) {
+			if (stopCv_.wait_for(lock, POLL_INTERVAL, [this] { return stop_.load(); })) break;
+			lock.unlock();
+			scanDirectory(true);
+			lock.lock();
+		}
+	}
+
+	void ConfigWatcher::scanDirectory(bool notify)
+	{
+		std::error_code ec;
+		std::filesystem::directory_iterator it(directory_, ec);
+		if (ec) return;
+
+		for (const auto& entry : it) {
+			if (!entry.is_regular_file(ec) || !isConfigFile(entry.path())) continue;
+
+			auto writeTime = entry.last_write_time(ec);
+			if (ec) continue;
+
+			std::string icao = entry.path().stem().string();
+			auto previous = lastWriteTimes_.find(icao);
+			bool changed = (previous == lastWriteTimes_.end() || previous->second != writeTime);
+			lastWriteTimes_[icao] = writeTime;
+
+			if (changed && notify && !stop_) callback_(icao);
+		}
+	}
+}
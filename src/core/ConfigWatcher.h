@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace stand
+{
+	// Watches the NeoSTAND config directory and reports which airport config changed
+	// (the bundle is reported by its file stem, "stands").
+	// Uses inotify on Linux and falls back to polling file timestamps elsewhere
+	// (or when inotify is unavailable). The callback runs on the watcher thread.
+	class ConfigWatcher
+	{
+	public:
+		using Callback = std::function<void(const std::string& icao)>;
+
+		ConfigWatcher(std::filesystem::path directory, Callback callback);
+		~ConfigWatcher();
+		ConfigWatcher(const ConfigWatcher&) = delete;
+		ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+		void start();
+		void stop();
+		bool isUsingInotify() const { return usingInotify_; }
+
+	private:
+		void run();
+		bool runInotify();
+		void runPolling();
+		void scanDirectory(bool notify);
+		bool isConfigFile(const std::filesystem::path& path) const;
+
+		std::filesystem::path directory_;
+		Callback callback_;
+		std::thread worker_;
+		std::atomic<bool> stop_ = false;
+		std::atomic<bool> usingInotify_ = false;
+
+		std::mutex stopMutex_;
+		std::condition_variable stopCv_;
+
+		// Polling fallback state: last seen write time per config file
+		std::unordered_map<std::string, std::filesystem::file_time_type> lastWriteTimes_;
+	};
+}
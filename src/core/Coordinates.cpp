@@ -0,0 +1,151 @@
+#include <algorithm>
+
+#include "Coordinates.h"
+
+namespace stand
+{
+	namespace
+	{
+		constexpr const int64_t MAX_DEGREES = 180;
+		constexpr const size_t MAX_DEGREE_DIGITS = 3;
+
+		bool isDigit(char c)
+		{
+			return c >= '0' && c <= '9';
+		}
+
+		// Reads a run of digits starting at pos, at most maxDigits are accumulated (extra ones are skipped)
+		size_t readDigits(std::string_view value, size_t& pos, int64_t& out, size_t maxDigits = 18)
+		{
+			size_t count = 0;
+			out = 0;
+			while (pos < value.size() && isDigit(value[pos])) {
+				if (count < maxDigits) out = out * 10 + (value[pos] - '0');
+				++count;
+				++pos;
+			}
+			return count;
+		}
+
+		constexpr int64_t pow10(size_t n)
+		{
+			int64_t result = 1;
+			while (n--) result *= 10;
+			return result;
+		}
+
+		int64_t maxMagnitude(Axis axis)
+		{
+			return (axis == Axis::latitude ? 90LL : MAX_DEGREES) * COORDINATE_SCALE;
+		}
+
+		// Whole degrees: at most 3 digits and 180, checked before anything is multiplied
+		bool readDegrees(std::string_view value, size_t& pos, int64_t& deg)
+		{
+			const size_t digits = readDigits(value, pos, deg, MAX_DEGREE_DIGITS);
+			return digits != 0 && digits <= MAX_DEGREE_DIGITS && deg <= MAX_DEGREES;
+		}
+
+		// "043.37.59.110" after the hemisphere letter
+		std::optional<int64_t> parseDms(std::string_view value)
+		{
+			size_t pos = 0;
+			int64_t deg = 0, min = 0, sec = 0, frac = 0;
+
+			if (!readDegrees(value, pos, deg) || pos >= value.size() || value[pos++] != '.') return std::nullopt;
+			if (readDigits(value, pos, min) == 0 || pos >= value.size() || value[pos++] != '.') return std::nullopt;
+			if (readDigits(value, pos, sec) == 0) return std::nullopt;
+
+			size_t fracDigits = 0;
+			if (pos < value.size() && value[pos] == '.') {
+				++pos;
+				fracDigits = std::min<size_t>(readDigits(value, pos, frac, 3), 3);
+				if (fracDigits == 0) return std::nullopt;
+			}
+			if (pos != value.size() || min >= 60 || sec >= 60) return std::nullopt;
+
+			const int64_t milliseconds = frac * pow10(3 - fracDigits);
+			const int64_t totalMs = ((deg * 60 + min) * 60 + sec) * 1000 + milliseconds;
+			// 1 degree = 3 600 000 ms, so ms -> 1e-7 degree is * 100 / 36, rounded
+			return (totalMs * 100 + 18) / 36;
+		}
+
+		// "49.014006", sign already removed
+		std::optional<int64_t> parseDecimal(std::string_view value)
+		{
+			size_t pos = 0;
+			int64_t whole = 0, frac = 0;
+
+			if (!readDegrees(value, pos, whole)) return std::nullopt;
+
+			size_t fracDigits = 0;
+			if (pos < value.size() && value[pos] == '.') {
+				++pos;
+				fracDigits = std::min<size_t>(readDigits(value, pos, frac, 7), 7);
+				if (fracDigits == 0) return std::nullopt;
+			}
+			if (pos != value.size()) return std::nullopt;
+
+			return whole * COORDINATE_SCALE + frac * pow10(7 - fracDigits);
+		}
+	}
+
+	std::optional<int32_t> parseCoordinate(std::string_view value, Axis axis)
+	{
+		if (value.empty()) return std::nullopt;
+
+		const bool latitude = axis == Axis::latitude;
+		int64_t sign = 1;
+		std::optional<int64_t> magnitude;
+
+		switch (value[0]) {
+		case 'N': case 'n':
+		case 'E': case 'e':
+			if (latitude != (value[0] == 'N' || value[0] == 'n')) return std::nullopt;
+			magnitude = parseDms(value.substr(1));
+			break;
+		case 'S': case 's':
+		case 'W': case 'w':
+			if (latitude != (value[0] == 'S' || value[0] == 's')) return std::nullopt;
+			sign = -1;
+			magnitude = parseDms(value.substr(1));
+			break;
+		case '-':
+			sign = -1;
+			magnitude = parseDecimal(value.substr(1));
+			break;
+		case '+':
+			magnitude = parseDecimal(value.substr(1));
+			break;
+		default:
+			magnitude = parseDecimal(value);
+			break;
+		}
+
+		if (!magnitude || *magnitude > maxMagnitude(axis)) return std::nullopt;
+		return static_cast<int32_t>(sign * *magnitude);
+	}
+
+	std::optional<StandPosition> parseStandPosition(std::string_view value)
+	{
+		size_t first = value.find(':');
+		if (first == std::string_view::npos) return std::nullopt;
+		size_t second = value.find(':', first + 1);
+
+		std::optional<int32_t> latitude = parseCoordinate(value.substr(0, first), Axis::latitude);
+		std::optional<int32_t> longitude = parseCoordinate(value.substr(first + 1, second == std::string_view::npos ? std::string_view::npos : second - first - 1), Axis::longitude);
+		if (!latitude || !longitude) return std::nullopt;
+
+		StandPosition position;
+		position.latitude = *latitude;
+		position.longitude = *longitude;
+
+		if (second != std::string_view::npos) {
+			size_t pos = second + 1;
+			int64_t radius = 0;
+			if (readDigits(value, pos, radius, 6) == 0 || pos != value.size() || radius > UINT16_MAX) return std::nullopt;
+			position.radius = static_cast<uint16_t>(radius);
+		}
+		return position;
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace stand
+{
+	// Fixed point angle, 1e-7 degree units (~1 cm), fits int32 for the whole globe
+	constexpr const int32_t COORDINATE_SCALE = 10000000;
+
+	struct StandPosition
+	{
+		int32_t latitude = 0;
+		int32_t longitude = 0;
+		uint16_t radius = 0; // meters
+	};
+
+	enum class Axis : uint8_t
+	{
+		latitude,  // N/S, up to 90 degrees
+		longitude, // E/W, up to 180 degrees
+	};
+
+	// Parses one angle, either DMS "N043.37.59.110" / "E001.22.09.990"
+	// or signed decimal degrees "49.014006" / "-2.538408".
+	// The hemisphere letter and the range must fit the axis.
+	// Integer only, no allocation, no locale.
+	std::optional<int32_t> parseCoordinate(std::string_view value, Axis axis);
+
+	// Parses "lat:lon:radius", e.g. "N043.37.59.110:E001.22.09.990:25" or "49.014006:2.538408:25"
+	std::optional<StandPosition> parseStandPosition(std::string_view value);
+
+	inline double toDegrees(int32_t coordinate)
+	{
+		return static_cast<double>(coordinate) / COORDINATE_SCALE;
+	}
+}
@@ -1,5 +1,7 @@
 #include <algorithm>
+#include <cstdlib>
 #include <fstream>
+#include <random>
 
 #include "../NeoSTAND.h"
 #include "DataManager.h"
@@ -29,6 +31,34 @@ DataManager::DataManager(stand::NeoSTAND* neoSTAND)
 	controllerDataAPI_ = neoSTAND_->GetControllerDataAPI();
 
 	configPath_ = getDllDirectory();
+	openBundle();
+
+	const char* seed = std::getenv(stand::SEED_VARIABLE);
+	if (seed && *seed) {
+		seed_ = std::strtoull(seed, nullptr, 10);
+		clock_.useLogical();
+	}
+	else {
+		std::random_device device;
+		seed_ = (static_cast<uint64_t>(device()) << 32) | device();
+	}
+	loggerAPI_->log(Logger::LogLevel::Info, "Stand selection seed: " + std::to_string(seed_) + (clock_.isLogical() ? " (logical clock)" : ""));
+
+	configWatcher_ = std::make_unique<stand::ConfigWatcher>(configPath_ / "NeoSTAND",
+		[this](const std::string& name) {
+			if (name == std::filesystem::path(stand::bundle::FILE_NAME).stem().string()) reloadBundle();
+			else reloadConfig(name);
+		});
+	configWatcher_->start();
+}
+
+DataManager::~DataManager()
+{
+	// Stop background work first, it uses the rest of the DataManager
+	if (configWatcher_) configWatcher_->stop();
+	for (auto& prefetch : prefetchThreads_) {
+		if (prefetch.thread.joinable()) prefetch.thread.join();
+	}
 }
 
 
@@ -58,9 +88,12 @@ void DataManager::clearData()
 {
 	configPath_.clear();
 	pilots_.clear();
+	pilotHandles_.clear();
 	activeAirports_.clear();
-	occupiedStands_.clear();
-	blockedStands_.clear();
+	airportStands_.clear();
+	arrivalRunways_.clear();
+	taxiCosts_.clear();
+	failedAssignments_.clear();
 	if (aircraftAPI_)
 		aircraftAPI_ = nullptr;
 	if (flightplanAPI_)
@@ -71,8 +104,11 @@ void DataManager::clearData()
 
 void DataManager::clearJson()
 {
-	std::lock_guard<std::mutex> lock(dataMutex_);
-	configJson_.clear();
+	std::lock_guard<std::mutex> lock(configMutex_);
+	configCache_.clear();
+	missingConfigs_.clear();
+	configCacheHits_ = 0;
+	configCacheMisses_ = 0;
 }
 
 void DataManager::DisplayMessageFromDataManager(const std::string& message, const std::string& sender)
@@ -86,248 +122,636 @@ void DataManager::DisplayMessageFromDataManager(const std::string& message, cons
 }
 
 	
-int DataManager::retrieveConfigJson(const std::string& icao)
+int DataManager::retrieveConfigJson(const std::string& icao, bool chat)
 {
+    std::shared_ptr<const stand::StandTable> table = loadStandTable(icao, chat);
+    const stand::InternId icaoId = stand::intern(icao);
+
+    std::lock_guard<std::mutex> lock(configMutex_);
+    if (!table) {
+        const auto delay = missingConfigs_.nextDelay(icaoId, std::chrono::seconds(stand::CONFIG_RETRY_MIN), std::chrono::seconds(stand::CONFIG_RETRY_MAX));
+        if (missingConfigs_.record(icaoId, std::chrono::steady_clock::now(), delay)) {
+            loggerAPI_->log(Logger::LogLevel::Warning, "No usable config for " + icao + ", retrying in " + std::to_string(delay.count()) + "s");
+        }
+        return -1;
+    }
+    missingConfigs_.erase(icaoId);
+    configCache_[icaoId] = std::move(table);
+    return 0;
+}
+
+std::shared_ptr<const stand::StandTable> DataManager::loadStandTable(const std::string& icao, bool chat)
+{
+    auto notify = [this, chat](const std::string& message, const std::string& sender) {
+        if (chat) DisplayMessageFromDataManager(message, sender);
+    };
+
     std::string fileName = icao + ".json";
     std::filesystem::path jsonPath = configPath_ / "NeoSTAND" / fileName;
+    std::filesystem::path dbPath = configPath_ / "NeoSTAND" / (icao + stand::db::FILE_EXTENSION);
+
+    // Precedence: a loose <ICAO>.json (through its .nsdb while that is up to date) overrides everything, so a local
+    // edit can be tested without rebuilding anything. Without one, a standalone <ICAO>.nsdb (neostand-compile -o)
+    // and the bundle may both have the airport: the newer file wins, so a database left over from before the
+    // bundle was deployed doesn't shadow it.
+    std::error_code ec;
+    const bool hasJson = std::filesystem::exists(jsonPath, ec);
+    bool bundleFirst = false;
+    if (!hasJson) {
+        const std::filesystem::path bundlePath = configPath_ / "NeoSTAND" / stand::bundle::FILE_NAME;
+        const auto bundleTime = std::filesystem::last_write_time(bundlePath, ec);
+        if (!ec) {
+            const auto dbTime = std::filesystem::last_write_time(dbPath, ec);
+            bundleFirst = ec || bundleTime > dbTime;
+        }
+    }
+    auto fromBundle = [this, &icao]() {
+        std::shared_ptr<stand::StandTable> bundled = loadFromBundle(icao);
+        if (bundled) LOG_DEBUG(Logger::LogLevel::Info, "Loaded config for " + icao + " from " + stand::bundle::FILE_NAME);
+        return bundled;
+    };
+
+    if (bundleFirst) {
+        if (std::shared_ptr<stand::StandTable> bundled = fromBundle()) return bundled;
+    }
+    if (std::shared_ptr<stand::StandTable> stored = loadStandDatabase(dbPath, jsonPath)) {
+        LOG_DEBUG(Logger::LogLevel::Info, "Loaded config for " + icao + " from " + dbPath.string());
+        return stored;
+    }
+    if (!hasJson && !bundleFirst) {
+        if (std::shared_ptr<stand::StandTable> bundled = fromBundle()) return bundled;
+    }
 
-    std::ifstream config(jsonPath);
+    std::ifstream config(jsonPath, std::ios::binary);
     if (!config.is_open()) {
-        DisplayMessageFromDataManager("Could not open JSON file: " + jsonPath.string(), "DataManager");
+        notify("Could not open JSON file: " + jsonPath.string(), "DataManager");
         loggerAPI_->log(Logger::LogLevel::Error, "Could not open JSON file: " + jsonPath.string());
-        return -1;
+        return nullptr;
     }
+    std::string content((std::istreambuf_iterator<char>(config)), std::istreambuf_iterator<char>());
 
-    nlohmann::ordered_json parsed;
+    auto table = std::make_shared<stand::StandTable>();
+    std::string error;
     try {
-        config >> parsed;
-        if (parsed.contains("version")) {
-            if (!isCorrectJsonVersion(parsed["version"].get<std::string>(), fileName)) {
-                return -1;
+        // Sector package exports use the line based STAND: format, parsed without going through JSON
+        if (stand::isStandTextFormat(content)) {
+            if (!stand::parseStandText(content, icao, *table, error)) {
+                notify("Invalid config in stand file: " + error, fileName);
+                loggerAPI_->log(Logger::LogLevel::Error, "Invalid config in stand file " + jsonPath.string() + ": " + error);
+                return nullptr;
             }
         }
         else {
-            DisplayMessageFromDataManager("Config version missing in JSON file: " + fileName, "DataManager");
+            nlohmann::ordered_json parsed = nlohmann::ordered_json::parse(content);
+            if (parsed.contains("version")) {
+                if (!isCorrectJsonVersion(parsed["version"].get<std::string>(), fileName, chat)) {
+                    return nullptr;
+                }
+            }
+            else {
+                notify("Config version missing in JSON file: " + fileName, "DataManager");
+                loggerAPI_->log(Logger::LogLevel::Warning, "Config version missing in JSON file: " + jsonPath.string());
+            }
+
+            if (!stand::compileStandTable(parsed, icao, *table, error)) {
+                notify("Invalid config in JSON file: " + error, fileName);
+                loggerAPI_->log(Logger::LogLevel::Error, "Invalid config in JSON file " + jsonPath.string() + ": " + error);
+                return nullptr;
+            }
+        }
+        for (const std::string& warning : table->warnings) {
+            notify(warning, fileName);
+            loggerAPI_->log(Logger::LogLevel::Warning, warning);
+        }
+
+        if (!stand::writeStandDatabase(*table, dbPath, error)) {
+            loggerAPI_->log(Logger::LogLevel::Warning, error);
         }
     }
     catch (...) {
-        DisplayMessageFromDataManager("Error parsing JSON file: " + jsonPath.string(), "DataManager");
+        notify("Error parsing JSON file: " + jsonPath.string(), "DataManager");
         loggerAPI_->log(Logger::LogLevel::Error, "Error parsing JSON file: " + jsonPath.string());
-        return -1;
+        return nullptr;
     }
 
-    {
-        std::lock_guard<std::mutex> lock(dataMutex_);
-        configJson_ = std::move(parsed);
-    }
+    LOG_DEBUG(Logger::LogLevel::Info, "Loaded config for " + icao + " from " + jsonPath.string());
+    return table;
+}
 
-    return 0;
+std::shared_ptr<stand::StandTable> DataManager::loadStandDatabase(const std::filesystem::path& dbPath, const std::filesystem::path& jsonPath)
+{
+	std::error_code ec;
+	if (!std::filesystem::exists(dbPath, ec)) return nullptr;
+
+	auto dbTime = std::filesystem::last_write_time(dbPath, ec);
+	if (ec) return nullptr;
+	// Stale once its JSON is edited; without a JSON it is a standalone database (neostand-compile -o) used as is
+	auto jsonTime = std::filesystem::last_write_time(jsonPath, ec);
+	if (!ec && jsonTime > dbTime) return nullptr;
+
+	stand::StandDatabase database;
+	auto table = std::make_shared<stand::StandTable>();
+	std::string error;
+	if (!database.open(dbPath, error) || !database.toStandTable(*table, error)) {
+		loggerAPI_->log(Logger::LogLevel::Warning, error + ", falling back to JSON");
+		return nullptr;
+	}
+
+	if (!table->version.empty() && table->version != NEOSTAND_VERSION) return nullptr;
+	return table;
+}
+
+std::shared_ptr<stand::StandTable> DataManager::loadFromBundle(const std::string& icao)
+{
+	std::shared_ptr<const stand::StandBundle> bundle;
+	{
+		std::lock_guard<std::mutex> lock(configMutex_);
+		bundle = bundle_;
+	}
+	if (!bundle || !bundle->contains(icao)) return nullptr;
+
+	auto table = std::make_shared<stand::StandTable>();
+	std::string error;
+	if (!bundle->decode(icao, *table, error)) {
+		loggerAPI_->log(Logger::LogLevel::Error, error);
+		return nullptr;
+	}
+	return table;
+}
+
+void DataManager::openBundle()
+{
+	std::filesystem::path bundlePath = configPath_ / "NeoSTAND" / stand::bundle::FILE_NAME;
+	std::error_code ec;
+	std::shared_ptr<stand::StandBundle> bundle;
+
+	if (std::filesystem::exists(bundlePath, ec)) {
+		bundle = std::make_shared<stand::StandBundle>();
+		std::string error;
+		if (!bundle->open(bundlePath, error)) {
+			DisplayMessageFromDataManager("Could not load config bundle: " + error, "DataManager");
+			loggerAPI_->log(Logger::LogLevel::Error, error);
+			bundle.reset();
+		}
+		// One version for the whole bundle, checked once rather than per airport
+		else if (!bundle->version().empty() && !isCorrectJsonVersion(bundle->version(), stand::bundle::FILE_NAME)) {
+			bundle.reset();
+		}
+		else {
+			loggerAPI_->log(Logger::LogLevel::Info, "Config bundle loaded with " + std::to_string(bundle->size()) + " airports");
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(configMutex_);
+	bundle_ = std::move(bundle);
+}
+
+void DataManager::reloadBundle()
+{
+	openBundle();
+
+	std::vector<std::string> cached;
+	{
+		// The new bundle may have the airports that had no config
+		std::lock_guard<std::mutex> lock(configMutex_);
+		missingConfigs_.clear();
+		for (const auto& [icao, config] : configCache_) {
+			cached.push_back(stand::str(icao));
+		}
+	}
+	for (const auto& icao : cached) {
+		reloadConfig(icao);
+	}
+}
+
+bool DataManager::retrieveCorrectConfigJson(stand::InternId icao)
+{
+	std::shared_future<std::shared_ptr<const stand::StandTable>> pending;
+	bool chat = true;
+	{
+		std::lock_guard<std::mutex> lock(configMutex_);
+		if (configCache_.contains(icao)) {
+			++configCacheHits_;
+			return true;
+		}
+		auto it = pendingLoads_.find(icao);
+		if (it != pendingLoads_.end()) pending = it->second;
+		// A config that failed to load is not tried again for every pilot and every tick
+		else if (!missingConfigs_.shouldRetry(icao, std::chrono::steady_clock::now())) return false;
+		// Its error already went to the chat, retries only log
+		chat = !missingConfigs_.contains(icao);
+	}
+
+	++configCacheMisses_;
+	// A prefetch is already loading this airport, wait for it rather than parsing twice
+	if (pending.valid()) return pending.get() != nullptr;
+	return retrieveConfigJson(stand::str(icao), chat) != -1;
+}
+
+void DataManager::prefetchConfigs(const std::vector<stand::InternId>& airports)
+{
+	const auto activatedAt = std::chrono::steady_clock::now();
+
+	std::lock_guard<std::mutex> lock(configMutex_);
+
+	// Threads of earlier activations that are done only need joining
+	std::erase_if(prefetchThreads_, [](PrefetchThread& prefetch) {
+		if (!prefetch.done->load()) return false;
+		prefetch.thread.join();
+		return true;
+	});
+
+	for (const auto& icao : airports) {
+		ConfigLoadMetric& metric = configLoadMetrics_[icao];
+		metric.activatedAt = activatedAt;
+		metric.readyAfter.reset();
+
+		if (configCache_.contains(icao)) {
+			metric.readyAfter = std::chrono::microseconds(0);
+			continue;
+		}
+		if (pendingLoads_.contains(icao)) continue;
+
+		auto promise = std::make_shared<std::promise<std::shared_ptr<const stand::StandTable>>>();
+		pendingLoads_[icao] = promise->get_future().share();
+
+		auto done = std::make_shared<std::atomic<bool>>(false);
+		std::thread thread([this, icao, promise, done]() {
+			std::shared_ptr<const stand::StandTable> table = loadStandTable(stand::str(icao), false);
+			{
+				std::lock_guard<std::mutex> lock(configMutex_);
+				if (table) {
+					configCache_[icao] = table;
+					ConfigLoadMetric& metric = configLoadMetrics_[icao];
+					metric.readyAfter = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - metric.activatedAt);
+				}
+				pendingLoads_.erase(icao);
+			}
+			promise->set_value(table);
+			done->store(true);
+		});
+		prefetchThreads_.push_back({ std::move(thread), std::move(done) });
+	}
+}
+
+std::shared_ptr<const stand::StandTable> DataManager::getStandTable(stand::InternId icao)
+{
+	if (!retrieveCorrectConfigJson(icao)) return nullptr;
+
+	std::lock_guard<std::mutex> lock(configMutex_);
+	auto it = configCache_.find(icao);
+	return (it != configCache_.end()) ? it->second : nullptr;
 }
 
-bool DataManager::retrieveCorrectConfigJson(const std::string& icao)
+void DataManager::reloadConfig(const std::string& icao)
 {
-	if (!configJson_.contains(icao) || configJson_.empty()) {
-		if (retrieveConfigJson(icao) == -1) return false;
+	const stand::InternId icaoId = stand::InternPool::instance().find(icao);
+	{
+		// Airports never loaded are picked up lazily on their first assignment,
+		// one whose config was missing or broken is tried again right away
+		std::lock_guard<std::mutex> lock(configMutex_);
+		missingConfigs_.erase(icaoId);
+		if (!configCache_.contains(icaoId)) return;
+	}
+
+	// Rebuilt on the watcher thread, readers keep using the previous snapshot meanwhile
+	std::shared_ptr<const stand::StandTable> table = loadStandTable(icao);
+	if (!table) {
+		loggerAPI_->log(Logger::LogLevel::Warning, "Reload failed for " + icao + ", keeping previous config");
+		return;
 	}
-	return true;
+
+	// The new table becomes visible together with the held stands remapped to its ids,
+	// every assignment path reads the table under dataMutex_
+	std::shared_ptr<const stand::StandTable> previous; // released outside the locks
+	{
+		std::lock_guard<std::mutex> dataLock(dataMutex_);
+		{
+			std::lock_guard<std::mutex> lock(configMutex_);
+			previous = std::exchange(configCache_[icaoId], table);
+		}
+		carryOverAssignments(icaoId, *table);
+	}
+	loggerAPI_->log(Logger::LogLevel::Info, "Config reloaded for " + icao);
+	DisplayMessageFromDataManager("Config reloaded for " + icao, "DataManager");
+}
+
+std::shared_ptr<const stand::StandTable> DataManager::currentTable(stand::InternId icao, std::shared_ptr<const stand::StandTable> fallback)
+{
+	std::lock_guard<std::mutex> lock(configMutex_);
+	auto it = configCache_.find(icao);
+	return (it != configCache_.end()) ? it->second : fallback;
 }
 
-bool DataManager::isCorrectJsonVersion(const std::string& config_version, const std::string& fileName)
+void DataManager::carryOverAssignments(stand::InternId icao, const stand::StandTable& table)
+{
+	for (stand::InternId callsign : standsAt(icao).follow(table)) {
+		// Stand removed from the config, the pilot gets a new one
+		Pilot* pilot = findRegistered(callsign);
+		if (!pilot) continue;
+		LOG_DEBUG(Logger::LogLevel::Info, "Stand " + stand::str(pilot->stand) + " no longer exists, releasing it for " + stand::str(callsign));
+		pilot->stand = stand::NO_INTERN_ID;
+	}
+}
+
+DataManager::ConfigCacheStats DataManager::getConfigCacheStats()
+{
+	ConfigCacheStats stats;
+	stats.hits = configCacheHits_.load();
+	stats.misses = configCacheMisses_.load();
+
+	std::lock_guard<std::mutex> lock(configMutex_);
+	for (const auto& [icao, config] : configCache_) {
+		stats.airports.push_back(stand::str(icao));
+	}
+	std::sort(stats.airports.begin(), stats.airports.end());
+
+	for (const auto& [icao, metric] : configLoadMetrics_) {
+		std::optional<uint64_t> microseconds;
+		if (metric.readyAfter) microseconds = static_cast<uint64_t>(metric.readyAfter->count());
+		stats.readyTimes.emplace_back(stand::str(icao), microseconds);
+	}
+	std::sort(stats.readyTimes.begin(), stats.readyTimes.end());
+	return stats;
+}
+
+bool DataManager::isCorrectJsonVersion(const std::string& config_version, const std::string& fileName, bool chat)
 {
 	if (config_version == NEOSTAND_VERSION) {
 		return true;
 	}
 	else {
-		DisplayMessageFromDataManager("Config version mismatch! Expected: " + std::string(NEOSTAND_VERSION) + ", Found: " + config_version + ", please update your config files.", fileName);
+		if (chat) DisplayMessageFromDataManager("Config version mismatch! Expected: " + std::string(NEOSTAND_VERSION) + ", Found: " + config_version + ", please update your config files.", fileName);
 		loggerAPI_->log(Logger::LogLevel::Error, "Config version mismatch! Expected: " + std::string(NEOSTAND_VERSION) + ", Found: " + config_version + fileName);
 	}
 	return false;
 }
 
-bool DataManager::removePilot(const std::string& callsign)
+bool DataManager::removePilot(const std::string& callsignString)
 {
+    const stand::InternId callsign = stand::InternPool::instance().find(callsignString);
+    if (callsign == stand::NO_INTERN_ID) return false;
+
     std::lock_guard<std::mutex> lock(dataMutex_);
-    const size_t initial = pilots_.size();
+    auto handle = pilotHandles_.find(callsign);
+    if (handle == pilotHandles_.end()) return false;
+
+    if (const Pilot* pilot = pilots_.get(handle->second)) releaseStand(*pilot);
+    pilots_.erase(handle->second);
+    pilotHandles_.erase(handle);
+    failedAssignments_.erase(callsign);
+    return true;
+}
 
-    pilots_.erase(std::remove_if(pilots_.begin(), pilots_.end(),
-        [&callsign](const Pilot& p) { return p.callsign == callsign; }), pilots_.end());
+DataManager::Pilot* DataManager::findRegistered(stand::InternId callsign)
+{
+	auto handle = pilotHandles_.find(callsign);
+	return (handle != pilotHandles_.end()) ? pilots_.get(handle->second) : nullptr;
+}
 
-    occupiedStands_.erase(std::remove_if(occupiedStands_.begin(), occupiedStands_.end(),
-        [&callsign](const Stand& s) { return s.callsign == callsign; }), occupiedStands_.end());
+void DataManager::releaseStand(const Pilot& pilot)
+{
+	auto stands = airportStands_.find(pilot.destination);
+	if (stands != airportStands_.end()) stands->second.release(pilot.callsign);
+}
 
-    blockedStands_.erase(std::remove_if(blockedStands_.begin(), blockedStands_.end(),
-        [&callsign](const Stand& s) { return s.callsign == callsign; }), blockedStands_.end());
+const uint32_t* DataManager::taxiCostsFor(stand::InternId icao, const stand::StandTable& table)
+{
+	if (table.taxi.empty()) return nullptr;
+	TaxiCosts& costs = taxiCosts_[icao];
+	if (costs.epoch != table.index.epoch) {
+		auto runways = arrivalRunways_.find(icao);
+		costs.meters = (runways != arrivalRunways_.end()) ? table.taxi.closest(runways->second) : std::vector<uint32_t>{};
+		costs.epoch = table.index.epoch;
+	}
+	return costs.meters.empty() ? nullptr : costs.meters.data();
+}
 
-    return pilots_.size() < initial;
+stand::AirportStands& DataManager::standsAt(stand::InternId icao)
+{
+	auto [it, inserted] = airportStands_.try_emplace(icao);
+	if (inserted) it->second.reseed(stand::StandRandom::airportSeed(seed_, stand::str(icao)));
+	return it->second;
 }
 
-void DataManager::assignStands(Pilot& pilot)
+void DataManager::extendStays()
 {
-	std::lock_guard<std::mutex> lock(dataMutex_);
-	// Check if configJSON is already the right one, if not, retrieve it
-	if (!retrieveCorrectConfigJson(pilot.destination)) {
-		loggerAPI_->log(Logger::LogLevel::Warning, "Failed to retrieve config when assigning Stand for: " + pilot.destination);
-		pilot.stand = "";
-		return;
-	}
-	
-	nlohmann::json standsJson;
-	if (configJson_.contains("STAND"))
-		standsJson = configJson_["STAND"];
-	else {
-		loggerAPI_->log(Logger::LogLevel::Warning, "No STAND section in config for: " + pilot.destination);
-		pilot.stand = "";
-		return;
+	// Turnaround times are estimates, a pilot still connected has not left its stand yet
+	const stand::TimePoint until = clock_.now() + stand::STAY_MARGIN;
+	for (auto& [icao, stands] : airportStands_) {
+		for (stand::InternId callsign : stands.extendStays(until)) {
+			// Its stand won't be free by its ETA, assignPendingStands() gives it another one on this pass
+			failedAssignments_.erase(callsign);
+			Pilot* pilot = findRegistered(callsign);
+			if (!pilot) continue;
+			loggerAPI_->log(Logger::LogLevel::Info, "Stand " + stand::str(pilot->stand) + " at " + stand::str(icao) + " is still occupied, reassigning "
+				+ stand::str(callsign));
+			pilot->stand = stand::NO_INTERN_ID;
+		}
 	}
+}
 
-	LOG_DEBUG(Logger::LogLevel::Info, "Total stands available before filtering: " + std::to_string(standsJson.size()));
+bool DataManager::shouldRetry(const Pilot& pilot) const
+{
+	auto stands = airportStands_.find(pilot.destination);
+	const uint64_t releaseEpoch = stands == airportStands_.end() ? 0 : stands->second.occupancy().releaseEpoch();
+	return failedAssignments_.shouldRetry(pilot.callsign, std::chrono::steady_clock::now(), releaseEpoch);
+}
 
-	// Filter stands based on criteria
-	auto it = standsJson.begin();
+bool DataManager::recordFailure(const Pilot& pilot, uint64_t releaseEpoch)
+{
+	if (!findRegistered(pilot.callsign)) return false; // removed meanwhile, nothing to retry
+	return failedAssignments_.record(pilot.callsign, std::chrono::steady_clock::now(), std::chrono::seconds(0), releaseEpoch);
+}
 
-	while (it != standsJson.end()) {
-		const auto& stand = *it;
-		// Check WTC
-		if (stand.contains("WTC")) {
-			std::string wtc = stand["WTC"].get<std::string>();
-			if (wtc != "A" && wtc != pilot.aircraftWTC) {
-				it = standsJson.erase(it);
-				continue;
-			}
-		}
+stand::StandRequest DataManager::toStandRequest(const Pilot& pilot)
+{
+	stand::StandRequest request;
+	request.use = toStandUse(pilot.aircraftType);
+	request.wtc = pilot.aircraftWTC;
+	request.code = pilot.aircraftCode;
+	request.aircraftType = pilot.aircraftTypeKey;
+	request.schengen = pilot.isShengen;
+	request.national = pilot.isNational;
+	request.airline = pilot.airline;
+	return request;
+}
 
-		// Check USE
-		if (stand.contains("use")) {
-			std::string use = stand["use"].get<std::string>();
-			std::string pilotType;
-			switch (pilot.aircraftType) {
-			case AircraftType::airliner: pilotType = "A"; break;
-			case AircraftType::generalAviation: pilotType = "P"; break;
-			case AircraftType::helicopter: pilotType = "H"; break;
-			case AircraftType::military: pilotType = "M"; break;
-			case AircraftType::cargo: pilotType = "C"; break;
-			default: pilotType = ""; break;
-			}
-			if (use != pilotType) {
-				it = standsJson.erase(it);
-				continue;
-			}
+void DataManager::assignPendingStands()
+{
+	// Gather every unassigned arrival of this tick, per destination
+	std::unordered_map<stand::InternId, std::vector<Pilot>> pending;
+	{
+		std::lock_guard<std::mutex> lock(dataMutex_);
+		clock_.tick();
+		extendStays();
+		for (const auto& pilot : pilots_) {
+			if (pilot.stand == stand::NO_INTERN_ID && shouldRetry(pilot)) pending[pilot.destination].push_back(pilot);
 		}
+	}
 
-		// Check SHENGEN
-		if (stand.contains("shengen")) {
-			bool shengen = stand["shengen"].get<bool>();
-			if (shengen != pilot.isShengen) {
-				it = standsJson.erase(it);
-				continue;
-			}
+	for (auto& [icao, pilots] : pending) {
+		std::shared_ptr<const stand::StandTable> table = (pilots.size() > 1) ? getStandTable(icao) : nullptr;
+		if (!table) {
+			// Single arrival (or config missing, reported there): the greedy pick is already optimal
+			for (auto& pilot : pilots) assignStands(pilot);
+			continue;
 		}
 
-		// Check NATIONAL
-		if (stand.contains("national")) {
-			bool national = stand["national"].get<bool>();
-			if (national != pilot.isNational) {
-				it = standsJson.erase(it);
-				continue;
+		std::vector<stand::StandRequest> requests;
+		requests.reserve(pilots.size());
+		for (const auto& pilot : pilots) requests.push_back(toStandRequest(pilot));
+
+		std::vector<Pilot*> fallback;
+		{
+			std::lock_guard<std::mutex> lock(dataMutex_);
+			// A reload may have swapped the table since it was fetched
+			table = currentTable(icao, table);
+			stand::AirportStands& stands = standsAt(icao);
+			if (stands.tableEpoch() != table->index.epoch) carryOverAssignments(icao, *table);
+
+			std::vector<stand::TimePoint> etas;
+			etas.reserve(pilots.size());
+			for (const auto& pilot : pilots) etas.push_back(pilot.eta);
+
+			[[maybe_unused]] const auto start = std::chrono::steady_clock::now();
+			const std::vector<std::optional<stand::StandId>> matched = stands.match(*table, requests, etas, taxiCostsFor(icao, *table));
+			LOG_DEBUG(Logger::LogLevel::Info, "Batch matched " + std::to_string(pilots.size()) + " pilots at " + stand::str(icao) + " in "
+				+ std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()) + " us");
+
+			for (size_t i = 0; i < pilots.size(); ++i) {
+				// The matching ignores BLOCK relations, an earlier pick of this batch may have blocked this stand
+				if (matched[i] && stands.fits(*matched[i], pilots[i].eta, pilots[i].aircraftCode)) commitAssignment(pilots[i], *table, stands, *matched[i]);
+				else fallback.push_back(&pilots[i]);
 			}
 		}
 
-		// Check if stand is occupied
-		if (std::find_if(occupiedStands_.begin(), occupiedStands_.end(), [&it](const Stand& stand){ return it.key() == stand.name;}) != occupiedStands_.end()) {
-			it = standsJson.erase(it);
-			continue;
-		}
+		for (Pilot* pilot : fallback) assignStands(*pilot);
+	}
+}
 
-		// Check if stand is blocked
-		if (std::find_if(blockedStands_.begin(), blockedStands_.end(), [&it](const Stand& stand) { return it.key() == stand.name; }) != blockedStands_.end()) {
-			it = standsJson.erase(it);
-			continue;
-		}
+void DataManager::assignStands(Pilot& pilot)
+{
+	// Fetched before taking dataMutex_ so a cache miss never parses while holding it
+	std::shared_ptr<const stand::StandTable> table = getStandTable(pilot.destination);
+	if (!table) {
+		// Reported and paced per airport by the config loader (missingConfigs_)
+		pilot.stand = stand::NO_INTERN_ID;
+		return;
+	}
+
+	const stand::StandRequest request = toStandRequest(pilot);
+
+	std::lock_guard<std::mutex> lock(dataMutex_);
+
+	// A reload may have swapped the table since it was fetched
+	table = currentTable(pilot.destination, table);
+	stand::AirportStands& stands = standsAt(pilot.destination);
+	if (stands.tableEpoch() != table->index.epoch) carryOverAssignments(pilot.destination, *table);
+
+	LOG_DEBUG(Logger::LogLevel::Info, "Total stands available before filtering: " + std::to_string(table->size()));
 
-		++it; // Only increment if not erased
+	size_t rung = 0;
+	std::optional<stand::StandId> best = stands.select(*table, request, pilot.eta, taxiCostsFor(pilot.destination, *table), &rung);
+	if (best && rung > 0) {
+		LOG_DEBUG(Logger::LogLevel::Info, "No strict match for " + stand::str(pilot.callsign) + ", relaxed up to "
+			+ stand::toString(table->relaxations[rung - 1]));
 	}
+	if (!best) {
+		if (recordFailure(pilot, stands.occupancy().releaseEpoch())) {
+			loggerAPI_->log(Logger::LogLevel::Warning, "No suitable stand found for pilot: " + stand::str(pilot.callsign) + " at " + stand::str(pilot.destination)
+				+ " (attempt " + std::to_string(failedAssignments_.failures(pilot.callsign)) + ", retrying once a stand is released)");
+		}
+		pilot.stand = stand::NO_INTERN_ID;
+		return;
+	}
+	commitAssignment(pilot, *table, stands, *best);
+}
 
-	if (standsJson.empty()) {
-		loggerAPI_->log(Logger::LogLevel::Warning, "No suitable stand found for pilot: " + pilot.callsign + " at " + pilot.destination);
-		pilot.stand = "";
+void DataManager::commitAssignment(Pilot& pilot, const stand::StandTable& table, stand::AirportStands& stands, stand::StandId selected)
+{
+	// Callers work on a copy taken before dataMutex_, the pilot may have been removed since.
+	// Holding the stand then would leak it, nothing would ever release it.
+	Pilot* registered = findRegistered(pilot.callsign);
+	if (!registered) {
+		pilot.stand = stand::NO_INTERN_ID;
 		return;
 	}
 
-	LOG_DEBUG(Logger::LogLevel::Info, "Total stands available after filtering: " + std::to_string(standsJson.size()));
+	pilot.stand = stand::intern(table.names[selected]);
 
-	// Randomly select a stand from the filtered list
-	std::srand(static_cast<unsigned int>(std::time(nullptr)));
-	int randomIndex = std::rand() % standsJson.size();
-	const auto& selectedStand = standsJson[randomIndex];
-	pilot.stand = selectedStand.begin().key();
+	LOG_DEBUG(Logger::LogLevel::Info, "Assigned stand " + stand::str(pilot.stand) + " to pilot: " + stand::str(pilot.callsign));
 
-	LOG_DEBUG(Logger::LogLevel::Info, "Assigned stand " + pilot.stand + " to pilot: " + pilot.callsign);
+	failedAssignments_.erase(pilot.callsign);
 
-	// Mark the stand as occupied
-	Stand stand;
-	stand.name = pilot.stand;
-	stand.icao = pilot.destination;
-	stand.callsign = pilot.callsign;
-	occupiedStands_.push_back(stand);
+	// Keep the registry in sync with the caller's copy
+	registered->stand = pilot.stand;
 
-	// Check if the stand is blocking other stands
-	if (selectedStand.contains("BLOCK"))
-	{
-		for (const auto& blockedStandName : selectedStand["BLOCK"]) {
-			Stand blockedStand;
-			blockedStand.name = blockedStandName.get<std::string>();
-			blockedStand.icao = pilot.destination;
-			blockedStand.callsign = pilot.callsign;
-			blockedStands_.push_back(blockedStand);
-			LOG_DEBUG(Logger::LogLevel::Info, "Also blocking stand " + blockedStand.name + " due to assignment of " + pilot.stand);
-		}
+	// Mark the stand as occupied, replacing any stand the pilot held before.
+	// The stands it blocks are reserved for the same window.
+	stands.hold(pilot.callsign, pilot.stand, selected, pilot.eta, pilot.eta + stand::turnaroundFor(pilot.aircraftCode));
+#ifdef DEV
+	for (stand::StandId blocked : stands.occupancy().blocks(selected)) {
+		LOG_DEBUG(Logger::LogLevel::Info, "Also blocking stand " + table.names[blocked] + " due to assignment of " + stand::str(pilot.stand));
 	}
+#endif
 }
 
 void DataManager::PopulateActiveAirports()
 {
 	std::vector<Airport::AirportConfig> airports = airportAPI_->getConfigurations();
-	std::vector<std::string> activeAirports;
+	std::vector<stand::InternId> activeAirports;
+	std::unordered_map<stand::InternId, std::vector<std::string>> arrivalRunways;
 
 	for (const auto& airport : airports) {
 		if (airport.status == Airport::AirportStatus::Active) {
-			activeAirports.push_back(airport.icao);
+			activeAirports.push_back(stand::intern(airport.icao));
+			arrivalRunways[activeAirports.back()] = airport.arrRunways;
 		}
 	}
 
+	prefetchConfigs(activeAirports);
+
 	std::lock_guard<std::mutex> lock(dataMutex_);
 	activeAirports_ = std::move(activeAirports);
+	arrivalRunways_ = std::move(arrivalRunways);
+	taxiCosts_.clear();
 }
 
 std::vector<std::string> DataManager::getAllActiveAirports()
 {
+	std::vector<std::string> airports;
 	std::lock_guard<std::mutex> lock(dataMutex_);
-	return activeAirports_;
+	for (stand::InternId icao : activeAirports_) {
+		airports.push_back(stand::str(icao));
+	}
+	return airports;
 }
 
-std::vector<DataManager::Pilot> DataManager::getAllPilots()
+std::vector<stand::InternId> DataManager::getAllPilotCallsigns()
 {
+	std::vector<stand::InternId> callsigns;
 	std::lock_guard<std::mutex> lock(dataMutex_);
-	return pilots_;
+	callsigns.reserve(pilots_.size());
+	for (const auto& pilot : pilots_) callsigns.push_back(pilot.callsign);
+	return callsigns;
 }
 
-bool DataManager::pilotExists(const std::string& callsign)
+bool DataManager::pilotExists(const std::string& callsignString)
 {
-	if (callsign.empty()) return false;
+	const stand::InternId callsign = stand::InternPool::instance().find(callsignString);
+	if (callsign == stand::NO_INTERN_ID) return false;
 	std::lock_guard<std::mutex> lock(dataMutex_);
-	return std::any_of(pilots_.begin(), pilots_.end(),
-		[&callsign](const Pilot& p) { return p.callsign == callsign; });
+	return pilotHandles_.contains(callsign);
 }
 
-DataManager::Pilot DataManager::getPilotByCallsign(const std::string& callsign)
+DataManager::PilotHandle DataManager::findPilot(const std::string& callsignString)
 {
+	const stand::InternId callsign = stand::InternPool::instance().find(callsignString);
+	if (callsign == stand::NO_INTERN_ID) return PilotHandle{};
 	std::lock_guard<std::mutex> lock(dataMutex_);
-	for (const auto& pilot : pilots_)
-	{
-		if (pilot.callsign == callsign)
-			return pilot;
-	}
-	return Pilot{};
+	auto handle = pilotHandles_.find(callsign);
+	return (handle != pilotHandles_.end()) ? handle->second : PilotHandle{};
 }
 
 void DataManager::updateAllPilots()
@@ -339,53 +763,70 @@ void DataManager::updateAllPilots()
 	}
 }
 
-void DataManager::updatePilot(const std::string& callsign)
+DataManager::PilotHandle DataManager::updatePilot(const std::string& callsign)
 {
-	if (callsign.empty()) return;
+	if (callsign.empty()) return PilotHandle{};
+
+	// Known pilots are never recomputed here (see OnFlightplanUpdated), skip the API calls
+	if (PilotHandle known = findPilot(callsign)) return known;
 	
 	std::optional<Aircraft::Aircraft> aircraftOpt = aircraftAPI_->getByCallsign(callsign);
-	if (!aircraftOpt.has_value()) return;
+	if (!aircraftOpt.has_value()) return PilotHandle{};
 	
 	Aircraft::Aircraft aircraft = *aircraftOpt;
-	if (aircraft.position.altitude > stand::MAX_ALTITUDE) return;
+	if (aircraft.position.altitude > stand::MAX_ALTITUDE) return PilotHandle{};
 
 	std::optional<Flightplan::Flightplan> flightplan = flightplanAPI_->getByCallsign(aircraft.callsign);
-	if (!flightplan.has_value()) return;
+	if (!flightplan.has_value()) return PilotHandle{};
 
 	std::optional<double> distanceToDest = aircraftAPI_->getDistanceToDestination(aircraft.callsign);
-	if (!distanceToDest.has_value() || *distanceToDest > stand::MAX_DISTANCE) return;
+	if (!distanceToDest.has_value() || *distanceToDest > stand::MAX_DISTANCE) return PilotHandle{};
 
-	if (!isConcernedAircraft(*flightplan)) return;
+	if (!isConcernedAircraft(*flightplan)) return PilotHandle{};
 
-	{
-		std::lock_guard<std::mutex> lock(dataMutex_);
-		if (!pilots_.empty() && std::any_of(pilots_.begin(), pilots_.end(),
-			[&aircraft](const Pilot& p) { return p.callsign == aircraft.callsign; })) {
-			return; // Skip if pilot already exists
-		}
-	}
+	const stand::InternId callsignId = stand::intern(aircraft.callsign);
 
 	Pilot pilot;
-	pilot.callsign = aircraft.callsign;
-	pilot.destination = flightplan->destination;
+	pilot.callsign = callsignId;
+	pilot.destination = stand::intern(flightplan->destination);
+	pilot.airline = stand::airlineKey(aircraft.callsign);
 	pilot.isShengen = isShengen(*flightplan);
 	pilot.isNational = isNational(*flightplan);
 	pilot.aircraftType = getAircraftType(*flightplan);
-	pilot.aircraftWTC = flightplan->wakeCategory;
-	pilot.stand = "";
-
-	{
-		std::lock_guard<std::mutex> lock(dataMutex_);
-		pilots_.push_back(pilot);
+	pilot.aircraftWTC = stand::parseStandWtc(flightplan->wakeCategory).value_or(stand::StandWtc::any);
+	pilot.aircraftTypeKey = stand::aircraftTypeKey(flightplan->acType);
+	if (std::optional<stand::AircraftPerformance> performance = stand::findAircraft(flightplan->acType)) {
+		pilot.aircraftCode = performance->code;
 	}
+	pilot.stand = stand::NO_INTERN_ID;
+
+	std::lock_guard<std::mutex> lock(dataMutex_);
+	pilot.eta = stand::arrivalEta(clock_.now(), *distanceToDest);
+	// Another thread may have registered it meanwhile
+	auto [handle, inserted] = pilotHandles_.try_emplace(callsignId);
+	if (inserted) handle->second = pilots_.insert(pilot);
+	return handle->second;
 }
 
 void DataManager::removeAllPilots()
 {
 	std::lock_guard<std::mutex> lock(dataMutex_);
 	pilots_.clear();
-	occupiedStands_.clear();
-	blockedStands_.clear();
+	pilotHandles_.clear();
+	for (auto& [icao, stands] : airportStands_) stands.clear();
+	failedAssignments_.clear();
+}
+
+stand::StandUse DataManager::toStandUse(AircraftType type)
+{
+	switch (type) {
+	case AircraftType::airliner: return stand::StandUse::airliner;
+	case AircraftType::generalAviation: return stand::StandUse::generalAviation;
+	case AircraftType::helicopter: return stand::StandUse::helicopter;
+	case AircraftType::military: return stand::StandUse::military;
+	case AircraftType::cargo: return stand::StandUse::cargo;
+	default: return stand::StandUse::any;
+	}
 }
 
 DataManager::AircraftType DataManager::getAircraftType(const Flightplan::Flightplan& fp)
@@ -433,32 +874,103 @@ DataManager::AircraftType DataManager::getAircraftType(const Flightplan::Flightp
 std::vector<std::string> DataManager::getOccupiedStands()
 {
 	std::vector<std::string> stands;
-	std::lock_guard<std::mutex> lock(dataMutex_);
-	for (const auto& stand : occupiedStands_) {
-		stands.push_back(stand.name + " (" + stand.icao + ")");
+	{
+		std::lock_guard<std::mutex> lock(dataMutex_);
+		for (const auto& [icao, airport] : airportStands_) {
+			for (const auto& [callsign, stay] : airport.stays()) {
+				stands.push_back(stand::str(stay.name) + " (" + stand::str(icao) + ") " + stand::str(callsign));
+			}
+		}
 	}
+	std::sort(stands.begin(), stands.end());
 	return stands;
 }
 
 std::vector<std::string> DataManager::getBlockedStands()
 {
+	// Names come from the loaded tables, taken before dataMutex_ like getFreeStandCounts
+	std::unordered_map<stand::InternId, std::shared_ptr<const stand::StandTable>> tables;
+	{
+		std::lock_guard<std::mutex> lock(configMutex_);
+		tables = configCache_;
+	}
+
 	std::vector<std::string> stands;
 	std::lock_guard<std::mutex> lock(dataMutex_);
-	for (const auto& stand : blockedStands_) {
-		stands.push_back(stand.name + " (" + stand.icao + ")");
+	for (const auto& [icao, airport] : airportStands_) {
+		const stand::StandOccupancy& occupancy = airport.occupancy();
+		auto table = tables.find(icao);
+		if (table == tables.end() || !table->second || table->second->size() != occupancy.size()) continue;
+		occupancy.blocked().forEach([&](size_t id) {
+			stands.push_back(table->second->names[id] + " (" + stand::str(icao) + ")");
+		});
 	}
 	return stands;
 }
 
+uint64_t DataManager::getSeed()
+{
+	std::lock_guard<std::mutex> lock(dataMutex_);
+	return seed_;
+}
+
+void DataManager::setSeed(uint64_t seed)
+{
+	std::lock_guard<std::mutex> lock(dataMutex_);
+	seed_ = seed;
+	// Carries on from the current time, stays already held keep their windows
+	if (!clock_.isLogical()) clock_.useLogical(clock_.now());
+	for (auto& [icao, stands] : airportStands_) stands.reseed(stand::StandRandom::airportSeed(seed_, stand::str(icao)));
+}
+
+std::vector<std::string> DataManager::getFreeStandCounts()
+{
+	std::vector<stand::InternId> airports;
+	{
+		std::lock_guard<std::mutex> lock(dataMutex_);
+		airports = activeAirports_;
+	}
+
+	std::vector<std::string> lines;
+	for (stand::InternId icao : airports) {
+		std::shared_ptr<const stand::StandTable> table;
+		{
+			// Only report loaded configs, never trigger a load from a command
+			std::lock_guard<std::mutex> lock(configMutex_);
+			auto it = configCache_.find(icao);
+			if (it != configCache_.end()) table = it->second;
+		}
+		if (!table) {
+			lines.push_back(stand::str(icao) + ": config not loaded");
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(dataMutex_);
+		auto stands = airportStands_.find(icao);
+		const bool tracked = stands != airportStands_.end() && stands->second.occupancy().size() == table->size();
+
+		std::string line = stand::str(icao) + ":";
+		for (size_t level = 0; level < table->index.priorityValues.size(); ++level) {
+			const size_t total = table->index.byPriority[level].count();
+			const size_t free = tracked ? stands->second.occupancy().freeCount(level) : total;
+			const uint8_t priority = table->index.priorityValues[level];
+			line += " P" + (priority ? std::to_string(priority) : std::string("-")) + " " + std::to_string(free) + "/" + std::to_string(total);
+		}
+		lines.push_back(line);
+	}
+	return lines;
+}
+
 bool DataManager::isConcernedAircraft(const Flightplan::Flightplan& fp)
 {
+	// Active airports are always interned, an unknown ICAO cannot be one of them
+	const stand::InternId origin = stand::InternPool::instance().find(fp.origin);
+	const stand::InternId destination = stand::InternPool::instance().find(fp.destination);
+	if (origin == stand::NO_INTERN_ID && destination == stand::NO_INTERN_ID) return false;
+
 	std::lock_guard<std::mutex> lock(dataMutex_);
-	std::vector<std::string> activeAirports = activeAirports_;
-	auto itOrigin = std::find(activeAirports.begin(), activeAirports.end(), fp.origin);
-	auto itDestination = std::find(activeAirports.begin(), activeAirports.end(), fp.destination);
-	if (itOrigin != activeAirports.end() || itDestination != activeAirports.end())
-		return true;
-	return false;
+	return std::any_of(activeAirports_.begin(), activeAirports_.end(),
+		[origin, destination](stand::InternId icao) { return icao == origin || icao == destination; });
 }
 
 bool DataManager::isShengen(const Flightplan::Flightplan& fp)
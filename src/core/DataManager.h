@@ -3,14 +3,37 @@
 #include <filesystem>
 #include <nlohmann/json.hpp>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <optional>
+#include <thread>
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
+#include "AircraftDatabase.h"
+#include "AirportStands.h"
+#include "ConfigWatcher.h"
+#include "FailureBackoff.h"
+#include "StandBundle.h"
+#include "StandClock.h"
+#include "StandDatabase.h"
+#include "StandRandom.h"
+#include "StandTable.h"
+#include "StandTextParser.h"
+#include "utils/InternPool.h"
+#include "utils/SlotMap.h"
+
 using namespace PluginSDK;
 
 namespace stand
 {
 	constexpr const int MAX_DISTANCE = 25; // Max distance to consider an aircraft (in NM)
 	constexpr const int MAX_ALTITUDE = 5000; // Max altitude to consider an aircraft (in feet)
+	constexpr const int CONFIG_RETRY_MIN = 5; // First wait before retrying an airport whose config failed to load, doubled on each failure (in seconds)
+	constexpr const int CONFIG_RETRY_MAX = 5 * 60; // Longest wait before retrying an airport whose config failed to load (in seconds)
+	constexpr const char* SEED_VARIABLE = "NEOSTAND_SEED"; // Environment variable fixing the stand selection seed and the clock, to replay a session
 }
 
 class DataManager {
@@ -24,62 +47,114 @@ public:
 		cargo
 	};
 
+	// Strings are interned (see InternPool.h), use stand::str() to display them
 	struct Pilot {
-		std::string callsign;
-		std::string destination;
-		std::string aircraftWTC;
-		AircraftType aircraftType;
-		std::string stand;
-		bool isShengen;
-		bool isNational;
+		stand::InternId callsign = stand::NO_INTERN_ID;
+		stand::InternId destination = stand::NO_INTERN_ID;
+		uint32_t airline = 0; // stand::airlineKey() of the callsign
+		stand::StandWtc aircraftWTC = stand::StandWtc::any;
+		stand::StandCode aircraftCode = stand::StandCode::any; // from the type's wingspan, any when unknown
+		uint32_t aircraftTypeKey = 0; // stand::aircraftTypeKey() of the ICAO type, for RULES
+		AircraftType aircraftType = AircraftType::airliner;
+		stand::InternId stand = stand::NO_INTERN_ID;
+		stand::TimePoint eta = 0; // expected on-blocks time
+		bool isShengen = false;
+		bool isNational = false;
 
 		bool empty() const {
-			return callsign.empty();
+			return callsign == stand::NO_INTERN_ID;
 		}
 	};
 
-	struct Stand {
-		std::string name;
-		std::string icao;
-		std::string callsign;
+	// Stable reference to a registered pilot, stale once the pilot is removed
+	using PilotHandle = stand::SlotMap<Pilot>::Handle;
 
-		bool operator==(const Stand& other) const {
-			return name == other.name;
-		}
+	struct ConfigCacheStats {
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		std::vector<std::string> airports; // ICAOs currently held in cache
+		std::vector<std::pair<std::string, std::optional<uint64_t>>> readyTimes; // activation to config ready (us), empty while loading
 	};
 
 public:
 	DataManager(stand::NeoSTAND* neoSTAND);
-	~DataManager() = default;
+	~DataManager();
 
 	void clearData();
 	void clearJson();
 
 	static std::filesystem::path getDllDirectory();
 	void DisplayMessageFromDataManager(const std::string& message, const std::string& sender = "");
-	int retrieveConfigJson(const std::string& icao);
-	bool retrieveCorrectConfigJson(const std::string& icao);
-	bool isCorrectJsonVersion(const std::string& config_version, const std::string& fileName);
+	int retrieveConfigJson(const std::string& icao, bool chat = true);
+	// chat: also report errors in the chat, background loads only log them
+	std::shared_ptr<const stand::StandTable> loadStandTable(const std::string& icao, bool chat = true);
+	void reloadConfig(const std::string& icao);
+	std::shared_ptr<stand::StandTable> loadStandDatabase(const std::filesystem::path& dbPath, const std::filesystem::path& jsonPath);
+	std::shared_ptr<stand::StandTable> loadFromBundle(const std::string& icao);
+	void openBundle();
+	void reloadBundle();
+	bool retrieveCorrectConfigJson(stand::InternId icao);
+	void prefetchConfigs(const std::vector<stand::InternId>& airports);
+	std::shared_ptr<const stand::StandTable> getStandTable(stand::InternId icao);
+	ConfigCacheStats getConfigCacheStats();
+	bool isCorrectJsonVersion(const std::string& config_version, const std::string& fileName, bool chat = true);
 	void PopulateActiveAirports();
 	void updateAllPilots();
-	void updatePilot(const std::string& callsign);
+	// Registers the pilot when concerned and not known yet, null handle when not registered
+	PilotHandle updatePilot(const std::string& callsign);
 	void removeAllPilots();
 	bool removePilot(const std::string& callsign);
 	void assignStands(Pilot& pilot);
+	void assignPendingStands();
 
 	std::vector<std::string> getAllActiveAirports();
-	std::vector<Pilot> getAllPilots();
+	std::vector<stand::InternId> getAllPilotCallsigns();
 	bool pilotExists(const std::string& callsign);
-	Pilot getPilotByCallsign(const std::string& callsign);
+	PilotHandle findPilot(const std::string& callsign);
+	// Runs fn(const Pilot&) under dataMutex_ without copying the pilot, false when the handle is stale
+	template <typename Fn>
+	bool withPilot(PilotHandle handle, Fn&& fn)
+	{
+		std::lock_guard<std::mutex> lock(dataMutex_);
+		const Pilot* pilot = pilots_.get(handle);
+		if (!pilot) return false;
+		fn(*pilot);
+		return true;
+	}
 	AircraftType getAircraftType(const Flightplan::Flightplan& fp);
+	static stand::StandUse toStandUse(AircraftType type);
 	std::vector<std::string> getOccupiedStands();
 	std::vector<std::string> getBlockedStands();
+	std::vector<std::string> getFreeStandCounts();
+	uint64_t getSeed();
+	// Restarts every airport's stand selection sequence from seed, and moves to the logical clock
+	void setSeed(uint64_t seed);
 	
 	bool isConcernedAircraft(const Flightplan::Flightplan& fp);
 	bool isShengen(const Flightplan::Flightplan& fp);
 	bool isNational(const Flightplan::Flightplan& fp);
 
 private:
+	// Everything below but toStandRequest expects dataMutex_ held by the caller
+	// The cached table of the airport, fallback when there is none (cleared cache)
+	std::shared_ptr<const stand::StandTable> currentTable(stand::InternId icao, std::shared_ptr<const stand::StandTable> fallback);
+	// Remaps held stands to the table's StandIds by name (AirportStands::follow), pilots whose stand
+	// the table no longer has get a new one. Needed whenever the stands were mapped for another table.
+	void carryOverAssignments(stand::InternId icao, const stand::StandTable& table);
+	void commitAssignment(Pilot& pilot, const stand::StandTable& table, stand::AirportStands& stands, stand::StandId selected);
+	static stand::StandRequest toStandRequest(const Pilot& pilot);
+	void extendStays();
+	bool shouldRetry(const Pilot& pilot) const;
+	// Records the failure, returns whether this one should be logged
+	bool recordFailure(const Pilot& pilot, uint64_t releaseEpoch);
+	Pilot* findRegistered(stand::InternId callsign);
+	// Drops the pilot's stand and the blocks it holds, O(BLOCK degree)
+	void releaseStand(const Pilot& pilot);
+	// The airport's live stands, created with its tie-break sequence seeded from seed_
+	stand::AirportStands& standsAt(stand::InternId icao);
+	// Taxi meters per stand from the airport's active arrival runways, nullptr without taxi graph or known runway
+	const uint32_t* taxiCostsFor(stand::InternId icao, const stand::StandTable& table);
+
 	Aircraft::AircraftAPI* aircraftAPI_ = nullptr;
 	Flightplan::FlightplanAPI* flightplanAPI_ = nullptr;
 	Airport::AirportAPI* airportAPI_ = nullptr;
@@ -90,10 +165,61 @@ private:
 
 	std::mutex dataMutex_;
 	std::filesystem::path configPath_;
-	nlohmann::ordered_json configJson_;
-	std::vector<Pilot> pilots_;
-	std::vector<std::string> activeAirports_;
-	std::vector<Stand> occupiedStands_;
-	std::vector<Stand> blockedStands_;
+
+	// Compiled airport configs, kept for the whole session and shared by all pilots.
+	// Entries are immutable snapshots: a reload builds a new table and swaps the pointer,
+	// configMutex_ only ever guards the map lookup / pointer exchange.
+	// Lock order: dataMutex_ before configMutex_ (a reload swaps the table and remaps the held stands at once).
+	std::mutex configMutex_;
+	std::unordered_map<stand::InternId, std::shared_ptr<const stand::StandTable>> configCache_;
+	std::atomic<uint64_t> configCacheHits_ = 0;
+	std::atomic<uint64_t> configCacheMisses_ = 0;
+	// Airports whose config failed to load, not tried again before their delay (CONFIG_RETRY_MIN doubling up to
+	// CONFIG_RETRY_MAX) is over or the watcher sees their file change. Only the first failure goes to the chat.
+	stand::FailureBackoff missingConfigs_;
+	std::unique_ptr<stand::ConfigWatcher> configWatcher_;
+
+	// Optional multi-airport bundle, only the index is read up front, sections
+	// are decoded when an airport is first loaded. Swapped whole on reload.
+	std::shared_ptr<const stand::StandBundle> bundle_;
+
+	// Background loads started on airport activation
+	struct ConfigLoadMetric {
+		std::chrono::steady_clock::time_point activatedAt;
+		std::optional<std::chrono::microseconds> readyAfter;
+	};
+	std::unordered_map<stand::InternId, std::shared_future<std::shared_ptr<const stand::StandTable>>> pendingLoads_;
+	std::unordered_map<stand::InternId, ConfigLoadMetric> configLoadMetrics_;
+	// One thread per load, joined by the next prefetchConfigs() once done (or by the destructor)
+	struct PrefetchThread {
+		std::thread thread;
+		std::shared_ptr<std::atomic<bool>> done;
+	};
+	std::vector<PrefetchThread> prefetchThreads_;
+	// Registered pilots, dense for the per-tick walks, and their handles by callsign for O(1) lookups
+	stand::SlotMap<Pilot> pilots_;
+	std::unordered_map<stand::InternId, PilotHandle> pilotHandles_;
+	std::vector<stand::InternId> activeAirports_;
+	std::unordered_map<stand::InternId, std::vector<std::string>> arrivalRunways_; // from the airport configuration
+	// Held stands per airport, with the occupancy bitmaps ANDed with the StandIndex attribute bitmaps to get
+	// a pilot's candidate stands, the timeline telling when each held stand is actually needed (so a stand
+	// freed before a pilot's ETA can be given to it) and the candidate bitmaps cached per pilot profile
+	std::unordered_map<stand::InternId, stand::AirportStands> airportStands_;
+	// TaxiDistances::closest() for the active arrival runways, rebuilt when they or the config change
+	struct TaxiCosts {
+		uint64_t epoch = 0; // StandIndex::epoch of the config it was built from
+		std::vector<uint32_t> meters;
+	};
+	std::unordered_map<stand::InternId, TaxiCosts> taxiCosts_;
+
+	// Pilots the last assignment failed for, by callsign. They are skipped until a stand of
+	// their airport is released (StandOccupancy::releaseEpoch).
+	stand::FailureBackoff failedAssignments_;
+
+	// Tie-breaks between equally good stands, one generator per airport (AirportStands) seeded from seed_,
+	// so the same candidates are broken the same way
+	uint64_t seed_ = 0;
+	// ETAs and stays. Logical once the seed is fixed, ticked by assignPendingStands(), so a seeded session replays.
+	stand::StandClock clock_;
 
 };
\ No newline at end of file
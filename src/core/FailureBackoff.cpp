@@ -0,0 +1,37 @@
+#include <algorithm>
+#include <bit>
+
+#include "FailureBackoff.h"
+
+namespace stand
+{
+	bool FailureBackoff::shouldRetry(InternId key, Clock::time_point now, uint64_t epoch) const
+	{
+		auto it = entries_.find(key);
+		if (it == entries_.end()) return true;
+		if (now < it->second.retryAt) return false;
+		return it->second.epoch == 0 || it->second.epoch != epoch;
+	}
+
+	bool FailureBackoff::record(InternId key, Clock::time_point now, std::chrono::seconds delay, uint64_t epoch)
+	{
+		Entry& entry = entries_[key];
+		entry.epoch = epoch;
+		entry.retryAt = now + delay;
+		++entry.failures;
+		return std::has_single_bit(entry.failures);
+	}
+
+	std::chrono::seconds FailureBackoff::nextDelay(InternId key, std::chrono::seconds base, std::chrono::seconds max) const
+	{
+		// Past 2^16 the shift alone would overflow, the cap was reached long before
+		const uint32_t doublings = std::min<uint32_t>(failures(key), 16);
+		return std::min(base * (int64_t{ 1 } << doublings), max);
+	}
+
+	uint32_t FailureBackoff::failures(InternId key) const
+	{
+		auto it = entries_.find(key);
+		return it == entries_.end() ? 0 : it->second.failures;
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+
+#include "utils/InternPool.h"
+
+namespace stand
+{
+	// Keys (pilots, airports) whose last attempt failed, skipped until it is worth trying again:
+	// after a delay, once an epoch moved on (e.g. StandOccupancy::releaseEpoch), or both.
+	// Only the 1st, 2nd, 4th... failure of a key is reported for logging.
+	// Not thread safe, the owner guards it.
+	class FailureBackoff
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// False while the key waits: before its retry time, or while epoch is still the one it failed at.
+		// A failure recorded with epoch 0 only waits for its delay.
+		bool shouldRetry(InternId key, Clock::time_point now, uint64_t epoch = 0) const;
+		// One more failure of key, retried no earlier than now + delay; true when it should be logged
+		bool record(InternId key, Clock::time_point now, std::chrono::seconds delay, uint64_t epoch = 0);
+		// base doubled for every failure recorded so far, capped at max
+		std::chrono::seconds nextDelay(InternId key, std::chrono::seconds base, std::chrono::seconds max) const;
+
+		uint32_t failures(InternId key) const;
+		bool contains(InternId key) const { return entries_.contains(key); }
+		void erase(InternId key) { entries_.erase(key); }
+		void clear() { entries_.clear(); }
+
+	private:
+		struct Entry
+		{
+			uint64_t epoch = 0;
+			Clock::time_point retryAt{};
+			uint32_t failures = 0;
+		};
+		std::unordered_map<InternId, Entry> entries_;
+	};
+}
@@ -0,0 +1,105 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <Windows.h>
+#elif defined(__APPLE__) || defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace stand
+{
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	bool MappedFile::open(const std::filesystem::path& path, std::string& error)
+	{
+		close();
+
+#if defined(_WIN32)
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			error = "Could not open " + path.string();
+			return false;
+		}
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+			CloseHandle(file);
+			error = "Could not map empty file " + path.string();
+			return false;
+		}
+		// The view keeps the mapping and the file open, both handles can go right away
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (!mapping) {
+			error = "Could not map " + path.string();
+			return false;
+		}
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+		if (!view) {
+			error = "Could not map " + path.string();
+			return false;
+		}
+		data_ = static_cast<const uint8_t*>(view);
+		size_ = static_cast<size_t>(fileSize.QuadPart);
+#elif defined(__APPLE__) || defined(__linux__)
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			error = "Could not open " + path.string();
+			return false;
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size == 0) {
+			::close(fd);
+			error = "Could not map empty file " + path.string();
+			return false;
+		}
+		void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd); // the mapping keeps its own reference to the file
+		if (view == MAP_FAILED) {
+			error = "Could not map " + path.string();
+			return false;
+		}
+		data_ = static_cast<const uint8_t*>(view);
+		size_ = static_cast<size_t>(st.st_size);
+#else
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file.is_open()) {
+			error = "Could not open " + path.string();
+			return false;
+		}
+		contents_.resize(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+		if (contents_.empty() || !file.read(reinterpret_cast<char*>(contents_.data()), static_cast<std::streamsize>(contents_.size()))) {
+			contents_.clear();
+			error = "Could not read " + path.string();
+			return false;
+		}
+		data_ = contents_.data();
+		size_ = contents_.size();
+#endif
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (!data_) return;
+#if defined(_WIN32)
+		UnmapViewOfFile(data_);
+#elif defined(__APPLE__) || defined(__linux__)
+		munmap(const_cast<uint8_t*>(data_), size_);
+#else
+		contents_.clear();
+#endif
+		data_ = nullptr;
+		size_ = 0;
+	}
+}
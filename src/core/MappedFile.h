@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace stand
+{
+	// Read-only mapping of a whole file (mmap, MapViewOfFile on Windows), unmapped on destruction.
+	// Pages are loaded on first access and shared between processes mapping the same file.
+	// The file must be replaced (written aside then renamed), never rewritten in place, while mapped.
+	// Platforms without either API read the file into memory instead.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool open(const std::filesystem::path& path, std::string& error);
+		void close();
+
+		const uint8_t* data() const { return data_; }
+		size_t size() const { return size_; }
+
+	private:
+		const uint8_t* data_ = nullptr;
+		size_t size_ = 0;
+#if !defined(_WIN32) && !defined(__APPLE__) && !defined(__linux__)
+		std::vector<uint8_t> contents_;
+#endif
+	};
+}
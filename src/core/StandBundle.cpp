@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <zlib.h>
+
+#include "StandBundle.h"
+#include "StandDatabase.h"
+
+namespace stand
+{
+	namespace
+	{
+		void copyFixed(char* dest, size_t destSize, const std::string& value)
+		{
+			std::memset(dest, 0, destSize);
+			std::memcpy(dest, value.data(), std::min(value.size(), destSize));
+		}
+	}
+
+	bool writeStandBundle(const std::vector<StandTable>& tables, const std::filesystem::path& path, std::string& error)
+	{
+		const std::string version = tables.empty() ? std::string() : tables.front().version;
+
+		std::vector<bundle::IndexEntry> index(tables.size());
+		std::vector<std::vector<Bytef>> sections(tables.size());
+		uint32_t offset = static_cast<uint32_t>(sizeof(bundle::Header) + tables.size() * sizeof(bundle::IndexEntry));
+
+		for (size_t i = 0; i < tables.size(); ++i) {
+			const StandTable& table = tables[i];
+			if (table.version != version) {
+				error = "Config version mismatch in bundle: " + table.icao + " is '" + table.version + "', expected '" + version + "'";
+				return false;
+			}
+			if (table.icao.size() > sizeof(index[i].icao)) {
+				error = "ICAO code too long for bundle: " + table.icao;
+				return false;
+			}
+
+			const std::vector<char> image = serializeStandDatabase(table);
+			uLongf compressedSize = compressBound(static_cast<uLong>(image.size()));
+			sections[i].resize(compressedSize);
+			if (compress2(sections[i].data(), &compressedSize, reinterpret_cast<const Bytef*>(image.data()),
+				static_cast<uLong>(image.size()), Z_BEST_COMPRESSION) != Z_OK) {
+				error = "Could not compress bundle section for " + table.icao;
+				return false;
+			}
+			sections[i].resize(compressedSize);
+
+			bundle::IndexEntry& entry = index[i];
+			std::memset(&entry, 0, sizeof(entry));
+			copyFixed(entry.icao, sizeof(entry.icao), table.icao);
+			entry.offset = offset;
+			entry.compressedSize = static_cast<uint32_t>(compressedSize);
+			entry.rawSize = static_cast<uint32_t>(image.size());
+			offset += entry.compressedSize;
+		}
+
+		bundle::Header header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, bundle::MAGIC, sizeof(header.magic));
+		header.formatVersion = bundle::FORMAT_VERSION;
+		copyFixed(header.configVersion, sizeof(header.configVersion), version);
+		header.airportCount = static_cast<uint32_t>(tables.size());
+		header.indexOffset = sizeof(bundle::Header);
+
+		// Same tmp + rename dance as the stand database, readers never see a partial bundle
+		std::filesystem::path tmpPath = path;
+		tmpPath += ".tmp";
+		{
+			std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+			if (!out.is_open()) {
+				error = "Could not write bundle: " + tmpPath.string();
+				return false;
+			}
+			out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			if (!index.empty()) out.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size() * sizeof(bundle::IndexEntry)));
+			for (const auto& section : sections) {
+				out.write(reinterpret_cast<const char*>(section.data()), static_cast<std::streamsize>(section.size()));
+			}
+			if (!out) {
+				error = "Could not write bundle: " + tmpPath.string();
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tmpPath, path, ec);
+		if (ec) {
+			std::filesystem::remove(tmpPath, ec);
+			error = "Could not replace bundle: " + path.string();
+			return false;
+		}
+		return true;
+	}
+
+	bool StandBundle::open(const std::filesystem::path& path, std::string& error)
+	{
+		path_ = path;
+		version_.clear();
+		index_.clear();
+
+		std::ifstream in(path, std::ios::binary);
+		if (!in.is_open()) {
+			error = "Could not open bundle: " + path.string();
+			return false;
+		}
+
+		bundle::Header header;
+		if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+			|| std::memcmp(header.magic, bundle::MAGIC, sizeof(header.magic)) != 0
+			|| header.formatVersion != bundle::FORMAT_VERSION) {
+			error = "Unsupported bundle format: " + path.string();
+			return false;
+		}
+
+		std::error_code ec;
+		const uint64_t fileSize = std::filesystem::file_size(path, ec);
+		if (ec) {
+			error = "Could not open bundle: " + path.string();
+			return false;
+		}
+
+		std::vector<bundle::IndexEntry> entries(header.airportCount);
+		in.seekg(header.indexOffset);
+		if (!entries.empty() && !in.read(reinterpret_cast<char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(bundle::IndexEntry)))) {
+			error = "Corrupted bundle index: " + path.string();
+			return false;
+		}
+
+		for (const auto& entry : entries) {
+			if (uint64_t(entry.offset) + entry.compressedSize > fileSize) {
+				error = "Corrupted bundle index: " + path.string();
+				index_.clear();
+				return false;
+			}
+			index_.emplace(std::string(entry.icao, strnlen(entry.icao, sizeof(entry.icao))), entry);
+		}
+
+		version_.assign(header.configVersion, strnlen(header.configVersion, sizeof(header.configVersion)));
+		return true;
+	}
+
+	bool StandBundle::decode(const std::string& icao, StandTable& table, std::string& error) const
+	{
+		auto it = index_.find(icao);
+		if (it == index_.end()) {
+			error = icao + " not found in bundle " + path_.string();
+			return false;
+		}
+		const bundle::IndexEntry& entry = it->second;
+
+		std::vector<Bytef> compressed(entry.compressedSize);
+		std::ifstream in(path_, std::ios::binary);
+		in.seekg(entry.offset);
+		if (!in.read(reinterpret_cast<char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()))) {
+			error = "Could not read bundle section for " + icao;
+			return false;
+		}
+
+		std::vector<uint8_t> image(entry.rawSize);
+		uLongf imageSize = entry.rawSize;
+		if (uncompress(image.data(), &imageSize, compressed.data(), static_cast<uLong>(compressed.size())) != Z_OK || imageSize != entry.rawSize) {
+			error = "Corrupted bundle section for " + icao;
+			return false;
+		}
+
+		StandDatabase database;
+		return database.open(std::move(image), path_.string() + ":" + icao, error)
+			&& database.toStandTable(table, error);
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "StandTable.h"
+
+namespace stand
+{
+	// Multi-airport config bundle (stands.nsbundle), generated by neostand-compile --bundle.
+	// Layout: header | airport index | sections. Each section is a zlib compressed
+	// stand database image (see StandDatabase.h), decoded independently on first use.
+	// One config version for the whole bundle, so airports cannot drift apart.
+	namespace bundle
+	{
+		constexpr const char MAGIC[4] = { 'N', 'S', 'B', 'N' };
+		constexpr const uint32_t FORMAT_VERSION = 1;
+		constexpr const char* FILE_NAME = "stands.nsbundle";
+
+		struct Header
+		{
+			char magic[4];
+			uint32_t formatVersion;
+			char configVersion[16];
+			uint32_t airportCount;
+			uint32_t indexOffset;
+		};
+		static_assert(sizeof(Header) == 32, "bundle header must stay 32 bytes");
+
+		struct IndexEntry
+		{
+			char icao[8];
+			uint32_t offset;         // absolute file offset of the compressed section
+			uint32_t compressedSize;
+			uint32_t rawSize;        // size of the stand database image once inflated
+			uint32_t reserved;
+		};
+		static_assert(sizeof(IndexEntry) == 24, "bundle index entry must stay 24 bytes");
+	}
+
+	// All tables must share the same config version
+	bool writeStandBundle(const std::vector<StandTable>& tables, const std::filesystem::path& path, std::string& error);
+
+	// Reads the header and index only, sections stay on disk until decode() asks for them
+	class StandBundle
+	{
+	public:
+		bool open(const std::filesystem::path& path, std::string& error);
+
+		const std::string& version() const { return version_; }
+		size_t size() const { return index_.size(); }
+		bool contains(const std::string& icao) const { return index_.contains(icao); }
+
+		// Thread safe, each call reads and inflates its own section
+		bool decode(const std::string& icao, StandTable& table, std::string& error) const;
+
+	private:
+		std::filesystem::path path_;
+		std::string version_;
+		std::unordered_map<std::string, bundle::IndexEntry> index_;
+	};
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <chrono>
+
+#include "StandTimeline.h"
+
+namespace stand
+{
+	constexpr const int UPDATE_INTERVAL = 5; // Between two scope updates (pilot registration and batch assignment), also a logical clock tick (in seconds)
+	constexpr const int APPROACH_SPEED = 180; // Average speed from detection to touchdown, for the ETA (in kt)
+	constexpr const int TAXI_IN_TIME = 5 * 60; // Touchdown to on-blocks (in seconds)
+	constexpr const int STAY_MARGIN = 10 * 60; // A connected pilot keeps its stand at least this long ahead (in seconds)
+
+	// Time the ETAs and stays are computed from. Follows the wall clock, or in a seeded session
+	// a logical clock that only moves by tick(), once per scope update: the same traffic seen at
+	// the same updates then gets the same ETAs, hence the same stands.
+	class StandClock
+	{
+	public:
+		static constexpr TimePoint LOGICAL_START = 0;
+
+		bool isLogical() const { return logical_; }
+		void useWallClock() { logical_ = false; }
+		// From then on only tick() moves the clock
+		void useLogical(TimePoint start = LOGICAL_START)
+		{
+			logical_ = true;
+			now_ = start;
+		}
+
+		TimePoint now() const { return logical_ ? now_ : wallTime(); }
+		// Moves a logical clock forward, the wall clock moves on its own
+		void tick(TimePoint seconds = UPDATE_INTERVAL)
+		{
+			if (logical_) now_ += seconds;
+		}
+
+		static TimePoint wallTime()
+		{
+			return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+		}
+
+	private:
+		bool logical_ = false;
+		TimePoint now_ = LOGICAL_START;
+	};
+
+	// Expected on-blocks time of an aircraft distance NM from its destination at now
+	inline TimePoint arrivalEta(TimePoint now, double distance)
+	{
+		return now + static_cast<TimePoint>(distance * 3600.0 / APPROACH_SPEED) + TAXI_IN_TIME;
+	}
+}
@@ -0,0 +1,336 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "MappedFile.h"
+#include "StandDatabase.h"
+
+namespace stand
+{
+	namespace
+	{
+		constexpr const size_t SECTION_ALIGNMENT = 8;
+
+		size_t alignUp(size_t value)
+		{
+			return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+		}
+
+		class StringTableBuilder
+		{
+		public:
+			db::StringRef add(std::string_view value)
+			{
+				auto it = offsets_.find(std::string(value));
+				if (it != offsets_.end()) return { it->second, static_cast<uint32_t>(value.size()) };
+
+				uint32_t offset = static_cast<uint32_t>(data_.size());
+				data_.append(value);
+				offsets_.emplace(std::string(value), offset);
+				return { offset, static_cast<uint32_t>(value.size()) };
+			}
+
+			const std::string& data() const { return data_; }
+
+		private:
+			std::string data_;
+			std::unordered_map<std::string, uint32_t> offsets_;
+		};
+
+		void copyFixed(char* dest, size_t destSize, const std::string& value)
+		{
+			std::memset(dest, 0, destSize);
+			std::memcpy(dest, value.data(), std::min(value.size(), destSize));
+		}
+
+		// Size of one element of each section, in db::Section order
+		constexpr const size_t ELEMENT_SIZES[] = {
+			sizeof(db::StringRef),
+			sizeof(StandUse), sizeof(StandCode), sizeof(StandWtc), sizeof(uint8_t), sizeof(uint8_t),
+			sizeof(uint16_t),
+			sizeof(int32_t), sizeof(int32_t),
+			sizeof(uint32_t), sizeof(StandId),
+			sizeof(uint32_t), sizeof(db::StringRef),
+			sizeof(uint32_t), sizeof(uint32_t),
+			sizeof(db::StringRef),
+			sizeof(db::StringRef), sizeof(uint32_t),
+			sizeof(char),
+		};
+		static_assert(std::size(ELEMENT_SIZES) == static_cast<size_t>(db::Section::count), "one element size per section");
+
+		class ImageBuilder
+		{
+		public:
+			ImageBuilder() : buffer_(sizeof(db::Header), 0) {}
+
+			template <typename T>
+			void add(db::Section id, const T* values, size_t count)
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				buffer_.resize(alignUp(buffer_.size()), 0);
+				header_.section(id) = { static_cast<uint32_t>(buffer_.size()), static_cast<uint32_t>(count) };
+				const char* bytes = reinterpret_cast<const char*>(values);
+				if (count != 0) buffer_.insert(buffer_.end(), bytes, bytes + count * sizeof(T));
+			}
+			template <typename Container>
+			void add(db::Section id, const Container& values)
+			{
+				add(id, values.data(), values.size());
+			}
+
+			db::Header& header() { return header_; }
+
+			std::vector<char> finish()
+			{
+				std::memcpy(buffer_.data(), &header_, sizeof(header_));
+				return std::move(buffer_);
+			}
+
+		private:
+			db::Header header_{};
+			std::vector<char> buffer_;
+		};
+	}
+
+	std::vector<char> serializeStandDatabase(const StandTable& table)
+	{
+		StringTableBuilder strings;
+		auto addStrings = [&strings](const std::vector<std::string>& values) {
+			std::vector<db::StringRef> refs;
+			refs.reserve(values.size());
+			for (const std::string& value : values) refs.push_back(strings.add(value));
+			return refs;
+		};
+
+		ImageBuilder image;
+		db::Header& header = image.header();
+		std::memcpy(header.magic, db::MAGIC, sizeof(header.magic));
+		header.formatVersion = db::FORMAT_VERSION;
+		copyFixed(header.icao, sizeof(header.icao), table.icao);
+		copyFixed(header.configVersion, sizeof(header.configVersion), table.version);
+		for (size_t i = 0; i < table.relaxations.size() && i < sizeof(header.relaxations); ++i) {
+			header.relaxations[i] = static_cast<uint8_t>(table.relaxations[i]);
+		}
+		header.standCount = static_cast<uint32_t>(table.size());
+
+		image.add(db::Section::names, addStrings(table.names));
+		image.add(db::Section::use, table.use);
+		image.add(db::Section::code, table.code);
+		image.add(db::Section::wtc, table.wtc);
+		image.add(db::Section::flags, table.flags);
+		image.add(db::Section::priority, table.priority);
+		image.add(db::Section::radius, table.radius);
+		image.add(db::Section::latitude, table.latitude);
+		image.add(db::Section::longitude, table.longitude);
+		image.add(db::Section::blockOffsets, table.blockOffsets);
+		image.add(db::Section::blocks, table.blocks);
+		image.add(db::Section::airlineOffsets, table.airlineOffsets);
+		image.add(db::Section::airlines, addStrings(table.airlines));
+		image.add(db::Section::typeOffsets, table.typeOffsets);
+		image.add(db::Section::types, table.types);
+		image.add(db::Section::rules, addStrings(table.ruleSources));
+		image.add(db::Section::taxiRunways, addStrings(table.taxi.runways()));
+		image.add(db::Section::taxiMeters, table.taxi.matrix());
+		image.add(db::Section::strings, strings.data());
+		return image.finish();
+	}
+
+	bool writeStandDatabase(const StandTable& table, const std::filesystem::path& path, std::string& error)
+	{
+		const std::vector<char> buffer = serializeStandDatabase(table);
+
+		// Write next to the target then rename, so a reader never loads a half-written file
+		std::filesystem::path tmpPath = path;
+		tmpPath += ".tmp";
+		{
+			std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+			if (!out.is_open()) {
+				error = "Could not write stand database: " + tmpPath.string();
+				return false;
+			}
+			out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			if (!out) {
+				error = "Could not write stand database: " + tmpPath.string();
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tmpPath, path, ec);
+		if (ec) {
+			std::filesystem::remove(tmpPath, ec);
+			error = "Could not replace stand database: " + path.string();
+			return false;
+		}
+		return true;
+	}
+
+	bool StandDatabase::open(const std::filesystem::path& path, std::string& error)
+	{
+		close();
+		auto file = std::make_shared<MappedFile>();
+		if (!file->open(path, error)) {
+			error = "Could not open stand database: " + error;
+			return false;
+		}
+		data_ = file->data();
+		size_ = file->size();
+		image_ = std::move(file);
+		return locateSections(path.string(), error);
+	}
+
+	bool StandDatabase::open(std::vector<uint8_t> image, const std::string& source, std::string& error)
+	{
+		close();
+		auto owned = std::make_shared<std::vector<uint8_t>>(std::move(image));
+		data_ = owned->data();
+		size_ = owned->size();
+		image_ = std::move(owned);
+		return locateSections(source, error);
+	}
+
+	bool StandDatabase::locateSections(const std::string& source, std::string& error)
+	{
+		if (size_ < sizeof(db::Header)) {
+			error = "Stand database too small: " + source;
+			close();
+			return false;
+		}
+		const db::Header& head = header();
+		if (std::memcmp(head.magic, db::MAGIC, sizeof(head.magic)) != 0 || head.formatVersion != db::FORMAT_VERSION) {
+			error = "Unsupported stand database format: " + source;
+			close();
+			return false;
+		}
+		for (size_t i = 0; i < static_cast<size_t>(db::Section::count); ++i) {
+			const db::SectionRef& section = head.sections[i];
+			if (section.offset % SECTION_ALIGNMENT != 0 || section.offset < sizeof(db::Header)
+				|| section.offset + uint64_t(section.count) * ELEMENT_SIZES[i] > size_) {
+				error = "Corrupted stand database: " + source;
+				close();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void StandDatabase::close()
+	{
+		image_.reset();
+		data_ = nullptr;
+		size_ = 0;
+	}
+
+	bool StandDatabase::toStandTable(StandTable& table, std::string& error) const
+	{
+		if (!data_) {
+			error = "Stand database not open";
+			return false;
+		}
+
+		const db::Header& head = header();
+		const uint32_t standCount = head.standCount;
+		const uint32_t stringsSize = count(db::Section::strings);
+
+		table = StandTable{};
+		table.icao.assign(head.icao, strnlen(head.icao, sizeof(head.icao)));
+		table.version.assign(head.configVersion, strnlen(head.configVersion, sizeof(head.configVersion)));
+		auto corrupted = [&table, &error](const char* what) {
+			error = std::string("Corrupted ") + what + " in stand database for " + table.icao;
+			return false;
+		};
+
+		for (uint8_t rung : head.relaxations) {
+			if (rung == 0) break;
+			if (rung > static_cast<uint8_t>(Relaxation::use) || !table.addRelaxation(static_cast<Relaxation>(rung))) {
+				return corrupted("relaxation ladder");
+			}
+		}
+
+		// Strings are the only copies: names index the table, the rest is small and compiled or matched as text
+		auto readStrings = [&](db::Section id, std::vector<std::string>& out) {
+			const db::StringRef* refs = section<db::StringRef>(id);
+			out.reserve(count(id));
+			for (uint32_t i = 0; i < count(id); ++i) {
+				if (uint64_t(refs[i].offset) + refs[i].length > stringsSize) return false;
+				out.emplace_back(string(refs[i]));
+			}
+			return true;
+		};
+		if (count(db::Section::names) != standCount || !readStrings(db::Section::names, table.names)) return corrupted("stand names");
+		if (!readStrings(db::Section::airlines, table.airlines)) return corrupted("airline list");
+		if (!readStrings(db::Section::rules, table.ruleSources)) return corrupted("rule list");
+		std::vector<std::string> runways;
+		if (!readStrings(db::Section::taxiRunways, runways)) return corrupted("taxi runway list");
+
+		table.ids.reserve(standCount);
+		for (uint32_t i = 0; i < standCount; ++i) table.ids.emplace(table.names[i], static_cast<StandId>(i));
+		if (table.ids.size() != standCount) {
+			error = "Duplicate stand name in stand database for " + table.icao;
+			return false;
+		}
+
+		// Per stand columns, viewed in place once their size and values are checked
+		auto perStand = [&](db::Section id, auto& column, auto maxValue) {
+			using T = typename std::remove_reference_t<decltype(column)>::value_type;
+			const T* values = section<T>(id);
+			if (count(id) != standCount) return false;
+			for (uint32_t i = 0; i < standCount; ++i) {
+				if (static_cast<uint64_t>(values[i]) > static_cast<uint64_t>(maxValue)) return false;
+			}
+			column = Column<T>::view(values, standCount, image_);
+			return true;
+		};
+		if (!perStand(db::Section::use, table.use, StandUse::cargo)
+			|| !perStand(db::Section::code, table.code, StandCode::F)
+			|| !perStand(db::Section::wtc, table.wtc, StandWtc::J)
+			|| !perStand(db::Section::flags, table.flags, UINT8_MAX)
+			|| !perStand(db::Section::priority, table.priority, UINT8_MAX)
+			|| !perStand(db::Section::radius, table.radius, UINT16_MAX)) {
+			return corrupted("stand attributes");
+		}
+		auto positions = [&](db::Section id, Column<int32_t>& column) {
+			if (count(id) != standCount) return false;
+			column = Column<int32_t>::view(section<int32_t>(id), standCount, image_);
+			return true;
+		};
+		if (!positions(db::Section::latitude, table.latitude) || !positions(db::Section::longitude, table.longitude)) {
+			return corrupted("stand positions");
+		}
+
+		// CSR lists: offsets start at 0, never go back and end on the list size
+		auto csr = [&](db::Section offsetsId, Column<uint32_t>& offsets, uint32_t listSize) {
+			const uint32_t* values = section<uint32_t>(offsetsId);
+			if (count(offsetsId) != standCount + 1 || values[0] != 0 || values[standCount] != listSize) return false;
+			for (uint32_t i = 0; i < standCount; ++i) {
+				if (values[i + 1] < values[i]) return false;
+			}
+			offsets = Column<uint32_t>::view(values, standCount + 1, image_);
+			return true;
+		};
+		const StandId* blocks = section<StandId>(db::Section::blocks);
+		const uint32_t blockCount = count(db::Section::blocks);
+		if (!csr(db::Section::blockOffsets, table.blockOffsets, blockCount)
+			|| std::any_of(blocks, blocks + blockCount, [standCount](StandId blocked) { return blocked >= standCount; })) {
+			return corrupted("block index");
+		}
+		table.blocks = Column<StandId>::view(blocks, blockCount, image_);
+		if (!csr(db::Section::airlineOffsets, table.airlineOffsets, static_cast<uint32_t>(table.airlines.size()))) {
+			return corrupted("airline list");
+		}
+		if (!csr(db::Section::typeOffsets, table.typeOffsets, count(db::Section::types))) return corrupted("stand types");
+		table.types = Column<uint32_t>::view(section<uint32_t>(db::Section::types), count(db::Section::types), image_);
+
+		// Taxi distances are stored computed, the graph itself is not kept
+		if (uint64_t(count(db::Section::taxiMeters)) != uint64_t(runways.size()) * standCount) return corrupted("taxi distances");
+		table.taxi.assign(std::move(runways), Column<uint32_t>::view(section<uint32_t>(db::Section::taxiMeters), count(db::Section::taxiMeters), image_),
+			standCount);
+
+		table.index.build(table);
+		return table.rules.compile(table, error);
+	}
+}
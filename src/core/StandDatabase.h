@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "StandTable.h"
+
+namespace stand
+{
+	// Binary stand database (<ICAO>.nsdb), generated from the JSON config.
+	// Layout: header | one section per table column, in Section order | string table.
+	// Each section is the column's array as StandTable holds it, so a mapped file is used in place:
+	// decoding points the table's columns at the sections instead of copying them (see Column).
+	// All integers are little-endian, all offsets are absolute file offsets aligned to 8 bytes.
+	namespace db
+	{
+		constexpr const char MAGIC[4] = { 'N', 'S', 'D', 'B' };
+		constexpr const uint32_t FORMAT_VERSION = 7;
+		constexpr const char* FILE_EXTENSION = ".nsdb";
+
+		enum class Section : uint32_t
+		{
+			names,          // StringRef per stand
+			use,            // uint8_t per stand, same for code, wtc, flags and priority
+			code,
+			wtc,
+			flags,
+			priority,
+			radius,         // uint16_t per stand
+			latitude,       // int32_t per stand, same for longitude
+			longitude,
+			blockOffsets,   // uint32_t, standCount + 1
+			blocks,         // StandId
+			airlineOffsets, // uint32_t, standCount + 1
+			airlines,       // StringRef
+			typeOffsets,    // uint32_t, standCount + 1
+			types,          // uint32_t aircraftTypeKey()
+			rules,          // StringRef per RULES source line, compiled again on load
+			taxiRunways,    // StringRef per runway
+			taxiMeters,     // uint32_t, runways x stands matrix of taxi meters (TaxiDistances)
+			strings,        // char
+			count
+		};
+
+		struct SectionRef
+		{
+			uint32_t offset;
+			uint32_t count; // elements, not bytes
+		};
+
+		struct Header
+		{
+			char magic[4];
+			uint32_t formatVersion;
+			char icao[8];
+			char configVersion[16];
+			uint32_t standCount;
+			uint8_t relaxations[8]; // Relaxation ladder in order, 0 terminated
+			uint32_t reserved;
+			SectionRef sections[static_cast<size_t>(Section::count)];
+
+			const SectionRef& section(Section id) const { return sections[static_cast<size_t>(id)]; }
+			SectionRef& section(Section id) { return sections[static_cast<size_t>(id)]; }
+		};
+		static_assert(sizeof(Header) == 200, "stand database header must stay 200 bytes");
+
+		struct StringRef
+		{
+			uint32_t offset; // relative to the string table
+			uint32_t length;
+		};
+	}
+
+	// Encodes the table into a complete database image, as written to disk
+	std::vector<char> serializeStandDatabase(const StandTable& table);
+	bool writeStandDatabase(const StandTable& table, const std::filesystem::path& path, std::string& error);
+
+	// Read-only view of a stand database image, mapped from a file or handed over in memory
+	// (e.g. a decompressed bundle section). Sections are checked to fit when opening.
+	// Tables decoded from it share the image, which lives until the last of them is gone.
+	class StandDatabase
+	{
+	public:
+		bool open(const std::filesystem::path& path, std::string& error);
+		bool open(std::vector<uint8_t> image, const std::string& source, std::string& error);
+		void close();
+
+		const db::Header& header() const { return *reinterpret_cast<const db::Header*>(data_); }
+		uint32_t size() const { return header().standCount; }
+		template <typename T>
+		const T* section(db::Section id) const { return reinterpret_cast<const T*>(data_ + header().section(id).offset); }
+		uint32_t count(db::Section id) const { return header().section(id).count; }
+		std::string_view string(const db::StringRef& ref) const { return { section<char>(db::Section::strings) + ref.offset, ref.length }; }
+
+		// Points the table's columns at the image, only names, airlines and rules are decoded.
+		// Every value is checked, so a damaged image fails here rather than when a pilot is assigned.
+		bool toStandTable(StandTable& table, std::string& error) const;
+
+	private:
+		bool locateSections(const std::string& source, std::string& error);
+
+		std::shared_ptr<const void> image_; // MappedFile or std::vector<uint8_t>
+		const uint8_t* data_ = nullptr;
+		size_t size_ = 0;
+	};
+}
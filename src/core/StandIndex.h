@@ -0,0 +1,164 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace stand
+{
+	struct StandTable;
+	enum class StandUse : uint8_t;
+	enum class StandCode : uint8_t;
+	enum class StandWtc : uint8_t;
+	enum class Relaxation : uint8_t;
+
+	// Fixed size bitset over an airport's StandIds, one bit per stand.
+	// Words are plain uint64_t so the AND loops below vectorise (SSE2/AVX2/NEON)
+	// without any platform specific intrinsics.
+	class StandBitset
+	{
+	public:
+		StandBitset() = default;
+		explicit StandBitset(size_t size) { resize(size); }
+
+		void resize(size_t size)
+		{
+			size_ = size;
+			words_.assign((size + 63) / 64, 0);
+		}
+		void clear() { std::fill(words_.begin(), words_.end(), 0); }
+		void setAll()
+		{
+			std::fill(words_.begin(), words_.end(), ~uint64_t(0));
+			if (size_ % 64 != 0 && !words_.empty()) words_.back() = (uint64_t(1) << (size_ % 64)) - 1;
+		}
+
+		size_t size() const { return size_; }
+		size_t wordCount() const { return words_.size(); }
+		const uint64_t* data() const { return words_.data(); }
+		uint64_t* data() { return words_.data(); }
+
+		void set(size_t bit) { words_[bit / 64] |= uint64_t(1) << (bit % 64); }
+		void reset(size_t bit) { words_[bit / 64] &= ~(uint64_t(1) << (bit % 64)); }
+		bool test(size_t bit) const { return (words_[bit / 64] >> (bit % 64)) & 1; }
+
+		size_t count() const
+		{
+			size_t total = 0;
+			for (uint64_t word : words_) total += std::popcount(word);
+			return total;
+		}
+		bool any() const
+		{
+			for (uint64_t word : words_) if (word) return true;
+			return false;
+		}
+
+		// Position of the n-th set bit (0 based), size() when there are not that many
+		size_t nth(size_t n) const
+		{
+			for (size_t w = 0; w < words_.size(); ++w) {
+				uint64_t word = words_[w];
+				const size_t bits = std::popcount(word);
+				if (n >= bits) {
+					n -= bits;
+					continue;
+				}
+				while (n--) word &= word - 1; // drop the lowest set bits
+				return w * 64 + std::countr_zero(word);
+			}
+			return size_;
+		}
+
+		template <typename Fn>
+		void forEach(Fn&& fn) const
+		{
+			for (size_t w = 0; w < words_.size(); ++w) {
+				for (uint64_t word = words_[w]; word; word &= word - 1) {
+					fn(w * 64 + std::countr_zero(word));
+				}
+			}
+		}
+
+	private:
+		size_t size_ = 0;
+		std::vector<uint64_t> words_;
+	};
+
+	// 3-character airline designator packed into an integer ("AFR" from "AFR123"),
+	// 0 when the value does not start with one. Case-insensitive.
+	constexpr uint32_t airlineKey(std::string_view value)
+	{
+		if (value.size() < 3) return 0;
+		uint32_t key = 0;
+		for (size_t i = 0; i < 3; ++i) {
+			char c = value[i];
+			if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+			if (!((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))) return 0;
+			key = (key << 8) | static_cast<uint8_t>(c);
+		}
+		return key;
+	}
+
+	// What a pilot needs from a stand, every field can be "any"
+	struct StandRequest
+	{
+		StandUse use{};
+		StandWtc wtc{};
+		StandCode code{};
+		bool schengen = false;
+		bool national = false;
+		uint32_t airline = 0; // airlineKey(), 0 for no preference
+		uint32_t aircraftType = 0; // aircraftTypeKey(), 0 when unknown, only read by RULES
+	};
+
+	// Precomputed per-attribute bitmaps of an airport, built once with the table.
+	// Each bitmap already answers "which stands accept this value", stands without
+	// the restriction are included, so a request is a plain AND of one bitmap per attribute.
+	struct StandIndex
+	{
+		std::array<StandBitset, 6> byUse;   // indexed by StandUse
+		std::array<StandBitset, 5> byWtc;   // indexed by StandWtc
+		std::array<StandBitset, 7> byCode;  // indexed by StandCode, stands at least that large
+		std::array<StandBitset, 2> bySchengen; // [pilot is schengen]
+		std::array<StandBitset, 2> byNational; // [pilot is national]
+
+		// Priority levels in preference order: lowest PRIORITY value first, stands without one last.
+		// priorityLevel maps a stand to its position in priorityValues / byPriority.
+		std::vector<uint8_t> priorityValues;
+		std::vector<StandBitset> byPriority;
+		std::vector<uint8_t> priorityLevel;
+
+		// Inverted CALLSIGN lists: airline -> stands preferring it
+		std::unordered_map<uint32_t, StandBitset> byAirline;
+
+		// Relaxation ladder of the table, and every stand for the attributes a rung ignores
+		std::vector<Relaxation> relaxations;
+		StandBitset all;
+
+		// Distinct for every build(), memoised candidate sets of an older config are dropped on mismatch
+		uint64_t epoch = 0;
+
+		void build(const StandTable& table);
+
+		// out = the static part of candidates(): every attribute bitmap for the request, ignoring occupancy.
+		// relaxed holds a bit per ignored Relaxation (1 << rung).
+		void attributes(const StandRequest& request, StandBitset& out, uint32_t relaxed = 0) const;
+
+		// out = every attribute bitmap for the request, minus occupied and blocked stands,
+		// except those listed in released (held now but free when the pilot needs them).
+		// All bitsets must be sized to the airport's stand count.
+		void candidates(const StandRequest& request, const StandBitset& occupied, const StandBitset& blocked, StandBitset& out,
+			const StandBitset* released = nullptr) const;
+		// Same from a precomputed attributes() bitmap
+		void candidates(const StandBitset& attributes, const StandBitset& occupied, const StandBitset& blocked, StandBitset& out,
+			const StandBitset* released = nullptr) const;
+
+		// Narrows out to the stands preferring the request's airline, out is left
+		// untouched when the airline has no preferred stand among them
+		bool preferAirline(const StandRequest& request, StandBitset& out) const;
+	};
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <limits>
+
+#include "StandMatcher.h"
+
+namespace stand
+{
+	namespace
+	{
+		constexpr const int64_t FORBIDDEN = std::numeric_limits<int32_t>::max(); // well above UNASSIGNED, no overflow when summed
+
+		// Hungarian algorithm (potentials form), rows <= columns, cost is row-major.
+		// Returns the column matched to each row. O(rows^2 * columns).
+		std::vector<size_t> solveAssignment(const std::vector<int64_t>& cost, size_t rows, size_t columns)
+		{
+			const int64_t INF = std::numeric_limits<int64_t>::max() / 4;
+			std::vector<int64_t> u(rows + 1, 0), v(columns + 1, 0), minv(columns + 1);
+			std::vector<size_t> match(columns + 1, 0), way(columns + 1, 0); // 1 based, 0 = none
+			std::vector<char> used(columns + 1);
+
+			for (size_t row = 1; row <= rows; ++row) {
+				match[0] = row;
+				size_t column0 = 0;
+				std::fill(minv.begin(), minv.end(), INF);
+				std::fill(used.begin(), used.end(), 0);
+				do {
+					used[column0] = 1;
+					const size_t row0 = match[column0];
+					int64_t delta = INF;
+					size_t column1 = 0;
+					for (size_t column = 1; column <= columns; ++column) {
+						if (used[column]) continue;
+						const int64_t current = cost[(row0 - 1) * columns + (column - 1)] - u[row0] - v[column];
+						if (current < minv[column]) {
+							minv[column] = current;
+							way[column] = column0;
+						}
+						if (minv[column] < delta) {
+							delta = minv[column];
+							column1 = column;
+						}
+					}
+					for (size_t column = 0; column <= columns; ++column) {
+						if (used[column]) {
+							u[match[column]] += delta;
+							v[column] -= delta;
+						}
+						else {
+							minv[column] -= delta;
+						}
+					}
+					column0 = column1;
+				} while (match[column0] != 0);
+
+				do {
+					const size_t column1 = way[column0];
+					match[column0] = match[column1];
+					column0 = column1;
+				} while (column0 != 0);
+			}
+
+			std::vector<size_t> result(rows);
+			for (size_t column = 1; column <= columns; ++column) {
+				if (match[column] != 0) result[match[column] - 1] = column - 1;
+			}
+			return result;
+		}
+	}
+
+	std::vector<std::optional<StandId>> matchStands(const StandTable& table, const StandOccupancy& occupancy, const std::vector<StandRequest>& requests,
+		const std::vector<StandBitset>* released, CandidateCache* cache, const uint32_t* taxi)
+	{
+		std::vector<std::optional<StandId>> result(requests.size());
+		if (requests.empty()) return result;
+
+		// Candidate bitmaps per pilot, and the union of them as the matrix columns
+		std::vector<StandBitset> candidates(requests.size());
+		std::vector<StandBitset> preferred(requests.size());
+		std::vector<char> hasPreferred(requests.size(), 0);
+		std::vector<size_t> rungs(requests.size(), 0);
+		StandBitset columnsUsed(table.size());
+		CandidateCache local;
+		CandidateCache& profiles = cache ? *cache : local;
+		for (size_t i = 0; i < requests.size(); ++i) {
+			const CandidateProfile& profile = profiles.profile(table, requests[i]);
+			const StandBitset* free = released ? &(*released)[i] : nullptr;
+			table.index.candidates(profile.attributes, occupancy.occupied(), occupancy.blocked(), candidates[i], free);
+			if (!candidates[i].any()) {
+				rungs[i] = relaxedCandidates(table.index, profile, occupancy.occupied(), occupancy.blocked(), candidates[i], free);
+			}
+			else if (profile.hasAirline) {
+				table.index.candidates(profile.preferred, occupancy.occupied(), occupancy.blocked(), preferred[i], free);
+				hasPreferred[i] = preferred[i].any();
+			}
+			for (size_t w = 0; w < columnsUsed.wordCount(); ++w) {
+				columnsUsed.data()[w] |= candidates[i].data()[w];
+			}
+		}
+
+		std::vector<StandId> stands;
+		columnsUsed.forEach([&stands](size_t id) { stands.push_back(static_cast<StandId>(id)); });
+		if (stands.empty()) return result;
+
+		// One dummy "no stand" column per pilot so every row can always be matched
+		const size_t rows = requests.size();
+		const size_t columns = stands.size() + rows;
+		std::vector<int64_t> cost(rows * columns, matchCost::UNASSIGNED);
+
+		// Taxi cost only depends on the stand
+		std::vector<int64_t> taxiCost(stands.size(), 0);
+		if (taxi) {
+			for (size_t c = 0; c < stands.size(); ++c) {
+				taxiCost[c] = std::min<int64_t>(taxi[stands[c]] / matchCost::TAXI_METERS, matchCost::TAXI_MAX);
+			}
+		}
+
+		for (size_t i = 0; i < rows; ++i) {
+			const int pilotCode = static_cast<int>(requests[i].code);
+			for (size_t c = 0; c < stands.size(); ++c) {
+				const StandId id = stands[c];
+				int64_t& pair = cost[i * columns + c];
+				if (!candidates[i].test(id)) {
+					pair = FORBIDDEN;
+					continue;
+				}
+
+				const int standCode = static_cast<int>(table.code[id]);
+				const int64_t waste = (standCode == 0 || pilotCode == 0) ? 0 : standCode - pilotCode;
+				pair = table.index.priorityLevel[id] * matchCost::PRIORITY_LEVEL
+					+ waste * matchCost::SIZE_WASTE
+					+ static_cast<int64_t>(rungs[i]) * matchCost::RELAXED
+					+ taxiCost[c]
+					+ ((hasPreferred[i] && !preferred[i].test(id)) ? matchCost::NOT_PREFERRED : 0);
+			}
+		}
+
+		const std::vector<size_t> assignment = solveAssignment(cost, rows, columns);
+		for (size_t i = 0; i < rows; ++i) {
+			const size_t column = assignment[i];
+			if (column < stands.size() && cost[i * columns + column] != FORBIDDEN) result[i] = stands[column];
+		}
+		return result;
+	}
+}
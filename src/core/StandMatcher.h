@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "CandidateCache.h"
+#include "StandIndex.h"
+#include "StandOccupancy.h"
+#include "StandTable.h"
+
+namespace stand
+{
+	// Cost weights of a pilot -> stand pair, lower is better
+	namespace matchCost
+	{
+		constexpr const int64_t PRIORITY_LEVEL = 10;   // per priority level below the best one
+		constexpr const int64_t NOT_PREFERRED = 50;    // stand does not list the pilot's airline
+		constexpr const int64_t SIZE_WASTE = 100;      // per code letter the stand is larger than needed
+		constexpr const int64_t RELAXED = 1000;        // per relaxation rung needed to find the pilot a stand
+		constexpr const int64_t TAXI_METERS = 100;     // meters of taxi from the active runways per cost point
+		constexpr const int64_t TAXI_MAX = 100;        // cap, also the cost of a stand the taxi graph does not reach
+		constexpr const int64_t UNASSIGNED = 1000000;  // leaving a pilot without stand
+	}
+
+	// Assigns a whole batch of pilots of one airport at once, as a min-cost bipartite
+	// matching (Hungarian algorithm) over the free stands suitable for at least one pilot.
+	// Result is parallel to requests, nullopt where no stand could be given.
+	// BLOCK relations between the chosen stands are not modelled, the caller re-checks them.
+	// released[i], when given, lists the held stands that are free in time for pilot i.
+	// Candidate sets come from cache when given, otherwise from a cache local to the batch.
+	// taxi, when given, holds each stand's taxi meters from the active runways (TaxiDistances::closest).
+	std::vector<std::optional<StandId>> matchStands(const StandTable& table, const StandOccupancy& occupancy, const std::vector<StandRequest>& requests,
+		const std::vector<StandBitset>* released = nullptr, CandidateCache* cache = nullptr, const uint32_t* taxi = nullptr);
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+
+#include "StandOccupancy.h"
+
+namespace stand
+{
+	void StandOccupancy::reset(const StandTable& table)
+	{
+		occupied_.resize(table.size());
+		blocked_.resize(table.size());
+		occupyCounts_.assign(table.size(), 0);
+		blockCounts_.assign(table.size(), 0);
+		blockOffsets_ = table.blockOffsets;
+		blocks_ = table.blocks;
+		levels_ = table.index.priorityLevel;
+		tableEpoch_ = table.index.epoch;
+		++releaseEpoch_;
+
+		freeCounts_.resize(table.index.byPriority.size());
+		for (size_t level = 0; level < freeCounts_.size(); ++level) {
+			freeCounts_[level] = static_cast<uint32_t>(table.index.byPriority[level].count());
+		}
+	}
+
+	void StandOccupancy::update(StandId id, bool wasFree)
+	{
+		const bool free = isFree(id);
+		if (free == wasFree) return;
+		if (free) ++freeCounts_[levels_[id]];
+		else --freeCounts_[levels_[id]];
+	}
+
+	void StandOccupancy::occupy(StandId id)
+	{
+		const bool wasFree = isFree(id);
+		if (occupyCounts_[id]++ == 0) occupied_.set(id);
+		update(id, wasFree);
+	}
+
+	void StandOccupancy::release(StandId id)
+	{
+		if (occupyCounts_[id] == 0) return;
+		const bool wasFree = isFree(id);
+		if (--occupyCounts_[id] == 0) occupied_.reset(id);
+		update(id, wasFree);
+		++releaseEpoch_;
+	}
+
+	void StandOccupancy::block(StandId id)
+	{
+		const bool wasFree = isFree(id);
+		if (blockCounts_[id]++ == 0) blocked_.set(id);
+		update(id, wasFree);
+	}
+
+	void StandOccupancy::unblock(StandId id)
+	{
+		if (blockCounts_[id] == 0) return;
+		const bool wasFree = isFree(id);
+		if (--blockCounts_[id] == 0) blocked_.reset(id);
+		update(id, wasFree);
+		++releaseEpoch_;
+	}
+
+	void StandOccupancy::hold(StandId id)
+	{
+		occupy(id);
+		for (StandId blocked : blocks(id)) block(blocked);
+	}
+
+	void StandOccupancy::unhold(StandId id)
+	{
+		release(id);
+		for (StandId blocked : blocks(id)) unblock(blocked);
+	}
+
+	std::optional<StandId> StandOccupancy::selectBest(const StandIndex& index, const StandRequest& request, uint32_t random,
+		const StandBitset* released, const uint32_t* taxi) const
+	{
+		StandBitset candidates;
+		index.candidates(request, occupied_, blocked_, candidates, released);
+		index.preferAirline(request, candidates);
+		return pickByPriority(index, candidates, random, released && released->any(), taxi);
+	}
+
+	std::optional<StandId> StandOccupancy::selectBest(const StandIndex& index, const CandidateProfile& profile, uint32_t random,
+		const StandBitset* released, size_t* rung, const uint32_t* taxi) const
+	{
+		StandBitset candidates;
+		liveCandidates(index, profile, occupied_, blocked_, candidates, released);
+		const size_t relaxedRung = candidates.any() ? 0 : relaxedCandidates(index, profile, occupied_, blocked_, candidates, released);
+		if (rung) *rung = relaxedRung;
+		return pickByPriority(index, candidates, random, released && released->any(), taxi);
+	}
+
+	std::optional<StandId> StandOccupancy::pickByPriority(const StandIndex& index, StandBitset& candidates, uint32_t random, bool anyReleased,
+		const uint32_t* taxi) const
+	{
+		for (size_t level = 0; level < freeCounts_.size(); ++level) {
+			if (freeCounts_[level] == 0 && !anyReleased) continue;
+
+			const uint64_t* priority = index.byPriority[level].data();
+			uint64_t* words = candidates.data();
+			size_t count = 0;
+			for (size_t w = 0; w < candidates.wordCount(); ++w) {
+				count += std::popcount(words[w] & priority[w]);
+			}
+			if (count == 0) continue;
+
+			// Narrow to this level only once it is known to hold a candidate
+			for (size_t w = 0; w < candidates.wordCount(); ++w) {
+				words[w] &= priority[w];
+			}
+
+			// Then to the stands close to the runway, unreachable ones only when no stand is reachable
+			if (taxi) {
+				uint32_t closest = TaxiDistances::UNREACHABLE;
+				candidates.forEach([&](size_t id) { closest = std::min(closest, taxi[id]); });
+				if (closest != TaxiDistances::UNREACHABLE) {
+					const uint32_t limit = closest + TAXI_TOLERANCE;
+					candidates.forEach([&](size_t id) {
+						if (taxi[id] > limit) {
+							candidates.reset(id);
+							--count;
+						}
+					});
+				}
+			}
+			return static_cast<StandId>(candidates.nth(random % count));
+		}
+		return std::nullopt;
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "CandidateCache.h"
+#include "StandIndex.h"
+#include "StandTable.h"
+
+namespace stand
+{
+	// Live state of one airport's stands: occupied and blocked bitmaps plus the
+	// number of free stands per priority level, all updated incrementally.
+	// Both are reference counted, several pilots can hold or block the same stand
+	// (overlapping BLOCK lists, successive reservations on the timeline).
+	// A stand is free when both of its counts are zero.
+	class StandOccupancy
+	{
+	public:
+		// Sizes everything to the table and marks every stand free
+		void reset(const StandTable& table);
+
+		size_t size() const { return occupied_.size(); }
+		// StandIndex::epoch of the table given to reset(), StandIds are only valid for that table
+		uint64_t tableEpoch() const { return tableEpoch_; }
+		const StandBitset& occupied() const { return occupied_; }
+		const StandBitset& blocked() const { return blocked_; }
+
+		void occupy(StandId id);
+		void release(StandId id);
+		void block(StandId id);
+		void unblock(StandId id);
+
+		// occupy / release the stand together with every stand of its BLOCK list, O(degree)
+		void hold(StandId id);
+		void unhold(StandId id);
+
+		// BLOCK list of a stand, from the table given to reset()
+		std::span<const StandId> blocks(StandId id) const
+		{
+			return { blocks_.data() + blockOffsets_[id], blockOffsets_[id + 1] - blockOffsets_[id] };
+		}
+		uint16_t blockCount(StandId id) const { return blockCounts_[id]; }
+
+		// Bumped by reset() and whenever a hold or block is dropped, so a pilot that found
+		// no stand only needs another look once this moved on
+		uint64_t releaseEpoch() const { return releaseEpoch_; }
+
+		// Free stands at a level of StandIndex::priorityValues
+		uint32_t freeCount(size_t level) const { return level < freeCounts_.size() ? freeCounts_[level] : 0; }
+
+		// Airline preferred stands when one of them matches, otherwise every matching stand.
+		// Then the best priority level with a matching free stand, random pick within that level.
+		// Levels with no free stand at all are skipped without touching their bitmap,
+		// unless released lists held stands that will be free in time (see StandTimeline).
+		// taxi, when given, holds each stand's taxi meters from the active runways: the pick is then
+		// limited to the level's stands within TAXI_TOLERANCE of its closest one.
+		// Only the stand attributes are checked here, RULES come with a CandidateProfile.
+		std::optional<StandId> selectBest(const StandIndex& index, const StandRequest& request, uint32_t random,
+			const StandBitset* released = nullptr, const uint32_t* taxi = nullptr) const;
+		// Same from a memoised profile of the request, walking the airport's relaxation ladder
+		// when nothing matches strictly. rung, when given, receives relaxedCandidates()'s result.
+		std::optional<StandId> selectBest(const StandIndex& index, const CandidateProfile& profile, uint32_t random,
+			const StandBitset* released = nullptr, size_t* rung = nullptr, const uint32_t* taxi = nullptr) const;
+
+	private:
+		bool isFree(StandId id) const { return occupyCounts_[id] == 0 && blockCounts_[id] == 0; }
+		void update(StandId id, bool wasFree);
+		std::optional<StandId> pickByPriority(const StandIndex& index, StandBitset& candidates, uint32_t random, bool anyReleased,
+			const uint32_t* taxi) const;
+
+		StandBitset occupied_; // occupyCounts_ != 0
+		StandBitset blocked_;  // blockCounts_ != 0
+		std::vector<uint16_t> occupyCounts_;
+		std::vector<uint16_t> blockCounts_;
+		// The table's BLOCK graph (shared, not copied, when it views a stand database)
+		// and a copy of StandIndex::priorityLevel for the current table
+		Column<uint32_t> blockOffsets_;
+		Column<StandId> blocks_;
+		std::vector<uint8_t> levels_;
+		std::vector<uint32_t> freeCounts_;
+		uint64_t releaseEpoch_ = 0;
+		uint64_t tableEpoch_ = 0;
+	};
+}
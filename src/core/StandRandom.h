@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+namespace stand
+{
+	// xoshiro128** (Blackman & Vigna), 16 bytes of state and no global or shared state,
+	// so each airport draws from its own sequence. The same seed always gives the same
+	// sequence on every platform, unlike std::rand.
+	class StandRandom
+	{
+	public:
+		explicit StandRandom(uint64_t seed = 0) { reseed(seed); }
+
+		// The state is filled with splitmix64 of the seed, never all zero
+		void reseed(uint64_t seed)
+		{
+			for (size_t i = 0; i < 4; i += 2) {
+				const uint64_t value = splitmix64(seed);
+				state_[i] = static_cast<uint32_t>(value);
+				state_[i + 1] = static_cast<uint32_t>(value >> 32);
+			}
+		}
+
+		uint32_t next()
+		{
+			const uint32_t result = rotl(state_[1] * 5, 7) * 9;
+			const uint32_t t = state_[1] << 9;
+			state_[2] ^= state_[0];
+			state_[3] ^= state_[1];
+			state_[1] ^= state_[2];
+			state_[0] ^= state_[3];
+			state_[2] ^= t;
+			state_[3] = rotl(state_[3], 11);
+			return result;
+		}
+
+		uint32_t operator()() { return next(); }
+
+		// Seed of one airport's generator: the session seed mixed with the ICAO code,
+		// so airports don't share a sequence and the result doesn't depend on intern order
+		static uint64_t airportSeed(uint64_t seed, std::string_view icao)
+		{
+			uint64_t hash = 0xCBF29CE484222325ull; // FNV-1a
+			for (char c : icao) {
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 0x100000001B3ull;
+			}
+			return seed ^ hash;
+		}
+
+	private:
+		static uint32_t rotl(uint32_t value, int bits)
+		{
+			return (value << bits) | (value >> (32 - bits));
+		}
+
+		static uint64_t splitmix64(uint64_t& seed)
+		{
+			uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		uint32_t state_[4];
+	};
+}
@@ -0,0 +1,411 @@
+#include <algorithm>
+#include <cctype>
+
+#include "AircraftDatabase.h"
+#include "StandRules.h"
+#include "StandTable.h"
+
+namespace stand
+{
+	namespace
+	{
+		std::string lower(std::string_view value)
+		{
+			std::string result(value);
+			std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return result;
+		}
+
+		std::vector<std::string_view> tokenize(std::string_view source)
+		{
+			std::vector<std::string_view> tokens;
+			size_t i = 0;
+			while (i < source.size()) {
+				const char c = source[i];
+				if (c == ' ' || c == '\t') {
+					++i;
+				}
+				else if ((c == '<' || c == '>') && i + 1 < source.size() && source[i + 1] == '=') {
+					tokens.push_back(source.substr(i, 2));
+					i += 2;
+				}
+				else if (c == '(' || c == ')' || c == ',' || c == '=') {
+					tokens.push_back(source.substr(i++, 1));
+				}
+				else {
+					const size_t start = i;
+					while (i < source.size() && (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_' || source[i] == '-' || source[i] == '*')) ++i;
+					if (i == start) {
+						tokens.push_back(source.substr(i++, 1)); // rejected by the parser
+						continue;
+					}
+					tokens.push_back(source.substr(start, i - start));
+				}
+			}
+			return tokens;
+		}
+
+		// Packed key back to text, 8 bits per character, trailing zeros dropped
+		std::string keyString(uint32_t key, int chars)
+		{
+			std::string result;
+			for (int i = chars - 1; i >= 0; --i) {
+				const char c = static_cast<char>((key >> (8 * i)) & 0xFF);
+				if (c != '\0') result.push_back(c);
+			}
+			return result;
+		}
+
+		// Recursive descent over one rule's condition, emitting postfix code
+		class RuleParser
+		{
+		public:
+			RuleParser(const std::vector<std::string_view>& tokens, size_t position, std::vector<RuleInstruction>& code,
+				std::vector<std::vector<uint32_t>>& sets)
+				: tokens_(tokens), position_(position), code_(code), sets_(sets)
+			{
+			}
+
+			bool parse(std::string& error)
+			{
+				if (!parseOr(error)) return false;
+				if (position_ != tokens_.size()) {
+					error = "unexpected '" + std::string(tokens_[position_]) + "'";
+					return false;
+				}
+				if (static_cast<size_t>(maxDepth_) > RuleProgram::MAX_DEPTH) {
+					error = "condition nested too deeply";
+					return false;
+				}
+				return true;
+			}
+
+		private:
+			bool accept(std::string_view keyword)
+			{
+				if (position_ < tokens_.size() && lower(tokens_[position_]) == keyword) {
+					++position_;
+					return true;
+				}
+				return false;
+			}
+
+			void emit(RuleOp op, uint32_t arg, int depthChange)
+			{
+				code_.push_back(RuleInstruction{ op, arg });
+				depth_ += depthChange;
+				maxDepth_ = std::max(maxDepth_, depth_);
+			}
+
+			bool parseOr(std::string& error)
+			{
+				if (!parseAnd(error)) return false;
+				while (accept("or")) {
+					if (!parseAnd(error)) return false;
+					emit(RuleOp::orOp, 0, -1);
+				}
+				return true;
+			}
+
+			bool parseAnd(std::string& error)
+			{
+				if (!parseNot(error)) return false;
+				while (accept("and")) {
+					if (!parseNot(error)) return false;
+					emit(RuleOp::andOp, 0, -1);
+				}
+				return true;
+			}
+
+			bool parseNot(std::string& error)
+			{
+				if (accept("not")) {
+					if (!parseNot(error)) return false;
+					emit(RuleOp::notOp, 0, 0);
+					return true;
+				}
+				if (accept("(")) {
+					if (!parseOr(error)) return false;
+					if (!accept(")")) {
+						error = "missing ')'";
+						return false;
+					}
+					return true;
+				}
+				return parsePredicate(error);
+			}
+
+			bool parseList(std::vector<std::string_view>& values, std::string& error)
+			{
+				do {
+					if (position_ >= tokens_.size()) {
+						error = "missing value";
+						return false;
+					}
+					values.push_back(tokens_[position_++]);
+				} while (accept(","));
+				return true;
+			}
+
+			bool parsePredicate(std::string& error)
+			{
+				if (position_ >= tokens_.size()) {
+					error = "missing condition";
+					return false;
+				}
+				const std::string name = lower(tokens_[position_++]);
+
+				if (name == "schengen" || name == "national") {
+					emit(name == "schengen" ? RuleOp::schengen : RuleOp::national, 0, 1);
+					return true;
+				}
+
+				if (name == "code") {
+					RuleOp op = RuleOp::codeEq;
+					if (accept(">=")) op = RuleOp::codeAtLeast;
+					else if (accept("<=")) op = RuleOp::codeAtMost;
+					else if (!accept("=")) {
+						error = "expected =, <= or >= after code";
+						return false;
+					}
+					std::optional<StandCode> code = (position_ < tokens_.size()) ? parseStandCode(tokens_[position_++]) : std::nullopt;
+					if (!code) {
+						error = "invalid code letter";
+						return false;
+					}
+					emit(op, static_cast<uint32_t>(*code), 1);
+					return true;
+				}
+
+				if (name != "type" && name != "airline" && name != "use" && name != "wtc") {
+					error = "unknown condition '" + name + "'";
+					return false;
+				}
+				std::vector<std::string_view> values;
+				if (!accept("=")) {
+					error = "expected = after " + name;
+					return false;
+				}
+				if (!parseList(values, error)) return false;
+
+				if (name == "use" || name == "wtc") {
+					uint32_t mask = 0;
+					for (std::string_view value : values) {
+						std::optional<uint8_t> bit;
+						if (name == "use") {
+							if (auto use = parseStandUse(value)) bit = static_cast<uint8_t>(*use);
+						}
+						else if (auto wtc = parseStandWtc(value)) {
+							bit = static_cast<uint8_t>(*wtc);
+						}
+						if (!bit) {
+							error = "invalid " + name + " '" + std::string(value) + "'";
+							return false;
+						}
+						mask |= 1u << *bit;
+					}
+					emit(name == "use" ? RuleOp::useIn : RuleOp::wtcIn, mask, 1);
+					return true;
+				}
+
+				std::vector<uint32_t> keys;
+				for (std::string_view value : values) {
+					const uint32_t key = (name == "type") ? aircraftTypeKey(value) : airlineKey(value);
+					if (key == 0 || (name == "airline" && value.size() != 3)) {
+						error = "invalid " + name + " '" + std::string(value) + "'";
+						return false;
+					}
+					keys.push_back(key);
+				}
+				std::sort(keys.begin(), keys.end());
+				keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+				sets_.push_back(std::move(keys));
+				emit(name == "type" ? RuleOp::typeIn : RuleOp::airlineIn, static_cast<uint32_t>(sets_.size() - 1), 1);
+				return true;
+			}
+
+			const std::vector<std::string_view>& tokens_;
+			size_t position_;
+			std::vector<RuleInstruction>& code_;
+			std::vector<std::vector<uint32_t>>& sets_;
+			int depth_ = 0;
+			int maxDepth_ = 0;
+		};
+
+		const char* opName(RuleOp op)
+		{
+			switch (op) {
+			case RuleOp::typeIn: return "TYPE IN";
+			case RuleOp::airlineIn: return "AIRLINE IN";
+			case RuleOp::useIn: return "USE IN";
+			case RuleOp::wtcIn: return "WTC IN";
+			case RuleOp::codeEq: return "CODE =";
+			case RuleOp::codeAtLeast: return "CODE >=";
+			case RuleOp::codeAtMost: return "CODE <=";
+			case RuleOp::schengen: return "SCHENGEN";
+			case RuleOp::national: return "NATIONAL";
+			case RuleOp::notOp: return "NOT";
+			case RuleOp::andOp: return "AND";
+			case RuleOp::orOp: return "OR";
+			default: return "?";
+			}
+		}
+	}
+
+	bool RuleProgram::compile(const StandTable& table, std::string& error)
+	{
+		code_.clear();
+		sets_.clear();
+		rules_.clear();
+
+		for (const std::string& source : table.ruleSources) {
+			const std::vector<std::string_view> tokens = tokenize(source);
+			CompiledRule rule;
+			rule.source = source;
+			rule.stands.resize(table.size());
+
+			// Stand list up to REQUIRE
+			size_t position = 0;
+			while (position < tokens.size() && lower(tokens[position]) != "require") {
+				std::string_view pattern = tokens[position++];
+				if (pattern == ",") continue;
+
+				size_t matches = 0;
+				if (pattern.ends_with('*')) {
+					const std::string_view prefix = pattern.substr(0, pattern.size() - 1);
+					for (size_t id = 0; id < table.size(); ++id) {
+						if (!table.names[id].starts_with(prefix)) continue;
+						rule.stands.set(id);
+						++matches;
+					}
+				}
+				else if (std::optional<StandId> id = table.find(pattern)) {
+					rule.stands.set(*id);
+					++matches;
+				}
+				if (matches == 0) {
+					error = "Rule '" + source + "' in " + table.icao + ": '" + std::string(pattern) + "' matches no stand";
+					return false;
+				}
+			}
+			if (position == tokens.size() || !rule.stands.any()) {
+				error = "Rule '" + source + "' in " + table.icao + ": expected <stands> REQUIRE <condition>";
+				return false;
+			}
+
+			rule.first = static_cast<uint32_t>(code_.size());
+			RuleParser parser(tokens, position + 1, code_, sets_);
+			std::string parseError;
+			if (!parser.parse(parseError)) {
+				error = "Rule '" + source + "' in " + table.icao + ": " + parseError;
+				return false;
+			}
+			rule.count = static_cast<uint32_t>(code_.size()) - rule.first;
+			rules_.push_back(std::move(rule));
+		}
+
+		// Stand types are resolved already, each restricted stand gets a single TYPE IN rule
+		for (size_t id = 0; id + 1 < table.typeOffsets.size(); ++id) {
+			const uint32_t first = table.typeOffsets[id];
+			const uint32_t last = table.typeOffsets[id + 1];
+			if (first == last) continue;
+
+			CompiledRule rule;
+			rule.source = table.names[id] + " atyp";
+			rule.stands.resize(table.size());
+			rule.stands.set(id);
+			std::vector<uint32_t> keys(table.types.begin() + first, table.types.begin() + last);
+			std::sort(keys.begin(), keys.end());
+			keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+			for (uint32_t key : keys) {
+				rule.source += ' ' + keyString(key, 4);
+			}
+			sets_.push_back(std::move(keys));
+			rule.first = static_cast<uint32_t>(code_.size());
+			code_.push_back(RuleInstruction{ RuleOp::typeIn, static_cast<uint32_t>(sets_.size() - 1) });
+			rule.count = 1;
+			rules_.push_back(std::move(rule));
+		}
+		return true;
+	}
+
+	bool RuleProgram::evaluate(const CompiledRule& rule, const StandRequest& request) const
+	{
+		bool stack[MAX_DEPTH];
+		size_t top = 0;
+		for (uint32_t pc = rule.first; pc < rule.first + rule.count; ++pc) {
+			const RuleInstruction& instruction = code_[pc];
+			const uint32_t code = static_cast<uint32_t>(request.code);
+			switch (instruction.op) {
+			case RuleOp::typeIn:
+				stack[top++] = std::binary_search(sets_[instruction.arg].begin(), sets_[instruction.arg].end(), request.aircraftType);
+				break;
+			case RuleOp::airlineIn:
+				stack[top++] = std::binary_search(sets_[instruction.arg].begin(), sets_[instruction.arg].end(), request.airline);
+				break;
+			case RuleOp::useIn: stack[top++] = (instruction.arg >> static_cast<uint32_t>(request.use)) & 1; break;
+			case RuleOp::wtcIn: stack[top++] = (instruction.arg >> static_cast<uint32_t>(request.wtc)) & 1; break;
+			// An aircraft of unknown size passes no code test
+			case RuleOp::codeEq: stack[top++] = code != 0 && code == instruction.arg; break;
+			case RuleOp::codeAtLeast: stack[top++] = code != 0 && code >= instruction.arg; break;
+			case RuleOp::codeAtMost: stack[top++] = code != 0 && code <= instruction.arg; break;
+			case RuleOp::schengen: stack[top++] = request.schengen; break;
+			case RuleOp::national: stack[top++] = request.national; break;
+			case RuleOp::notOp: stack[top - 1] = !stack[top - 1]; break;
+			case RuleOp::andOp: --top; stack[top - 1] = stack[top - 1] && stack[top]; break;
+			case RuleOp::orOp: --top; stack[top - 1] = stack[top - 1] || stack[top]; break;
+			}
+		}
+		return top == 1 && stack[0];
+	}
+
+	void RuleProgram::apply(const StandRequest& request, StandBitset& allowed) const
+	{
+		for (const CompiledRule& rule : rules_) {
+			if (evaluate(rule, request)) continue;
+			for (size_t w = 0; w < allowed.wordCount(); ++w) {
+				allowed.data()[w] &= ~rule.stands.data()[w];
+			}
+		}
+	}
+
+	std::string RuleProgram::dump() const
+	{
+		std::string out;
+		for (size_t r = 0; r < rules_.size(); ++r) {
+			const CompiledRule& rule = rules_[r];
+			out += "rule " + std::to_string(r) + ": " + rule.source + " (" + std::to_string(rule.stands.count()) + " stands)\n";
+			for (uint32_t pc = rule.first; pc < rule.first + rule.count; ++pc) {
+				const RuleInstruction& instruction = code_[pc];
+				out += "  " + std::to_string(pc) + "\t" + opName(instruction.op);
+				switch (instruction.op) {
+				case RuleOp::typeIn:
+				case RuleOp::airlineIn:
+					for (uint32_t key : sets_[instruction.arg]) {
+						out += ' ';
+						out += keyString(key, instruction.op == RuleOp::typeIn ? 4 : 3);
+					}
+					break;
+				case RuleOp::useIn:
+				case RuleOp::wtcIn:
+					for (uint32_t bit = 0; bit < 8; ++bit) {
+						if (!((instruction.arg >> bit) & 1)) continue;
+						out += ' ';
+						out += (instruction.op == RuleOp::useIn) ? toChar(static_cast<StandUse>(bit)) : toChar(static_cast<StandWtc>(bit));
+					}
+					break;
+				case RuleOp::codeEq:
+				case RuleOp::codeAtLeast:
+				case RuleOp::codeAtMost:
+					out += ' ';
+					out += toChar(static_cast<StandCode>(instruction.arg));
+					break;
+				default:
+					break;
+				}
+				out += '\n';
+			}
+		}
+		return out;
+	}
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "StandIndex.h"
+
+namespace stand
+{
+	struct StandTable;
+
+	// Airport RULES, one line each:
+	//
+	//   K10,K12,M* REQUIRE code >= E AND NOT airline = RYR,EZY
+	//   G* REQUIRE type = AT72,AT76 OR (use = P AND wtc = L,M)
+	//
+	// The stands on the left (exact names, or a prefix ending in '*') only take pilots for
+	// which the condition holds. Predicates on the pilot: type, airline, use and wtc with a
+	// comma separated list, code with =, <= or >= on a letter, and the schengen / national flags.
+	// NOT binds tightest, then AND, then OR. Keywords are case-insensitive.
+	//
+	// Rules compile to postfix bytecode over the request only, so evaluating them costs the
+	// same for 10 or 300 stands: a failing rule removes its precomputed stand bitmap.
+	enum class RuleOp : uint8_t
+	{
+		typeIn,    // arg = set index
+		airlineIn, // arg = set index
+		useIn,     // arg = StandUse bitmask
+		wtcIn,     // arg = StandWtc bitmask
+		codeEq,    // arg = StandCode
+		codeAtLeast,
+		codeAtMost,
+		schengen,
+		national,
+		notOp,
+		andOp,
+		orOp
+	};
+
+	struct RuleInstruction
+	{
+		RuleOp op;
+		uint32_t arg = 0;
+	};
+
+	struct CompiledRule
+	{
+		std::string source;
+		StandBitset stands;
+		uint32_t first = 0; // in RuleProgram::code
+		uint32_t count = 0;
+	};
+
+	class RuleProgram
+	{
+	public:
+		static constexpr const size_t MAX_DEPTH = 32;
+
+		// Compiles table.ruleSources against the table's stand names, then one rule per stand
+		// with types (table.types), replacing any previous program
+		bool compile(const StandTable& table, std::string& error);
+
+		bool empty() const { return rules_.empty(); }
+		size_t size() const { return rules_.size(); }
+
+		// allowed &= ~stands of every rule the request fails
+		void apply(const StandRequest& request, StandBitset& allowed) const;
+
+		// Bytecode listing, one rule after the other
+		std::string dump() const;
+
+	private:
+		bool evaluate(const CompiledRule& rule, const StandRequest& request) const;
+
+		std::vector<RuleInstruction> code_;
+		std::vector<std::vector<uint32_t>> sets_; // sorted type / airline keys
+		std::vector<CompiledRule> rules_;
+	};
+}
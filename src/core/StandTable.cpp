@@ -0,0 +1,380 @@
+#include <algorithm>
+#include <cctype>
+
+#include "AircraftDatabase.h"
+#include "StandTable.h"
+
+namespace stand
+{
+	namespace
+	{
+		// Single letter attribute, case-insensitive
+		char letter(std::string_view value)
+		{
+			return (value.size() == 1) ? static_cast<char>(std::toupper(static_cast<unsigned char>(value[0]))) : '\0';
+		}
+	}
+
+	std::optional<StandUse> parseStandUse(std::string_view value)
+	{
+		switch (letter(value)) {
+		case 'A': return StandUse::airliner;
+		case 'P': return StandUse::generalAviation;
+		case 'H': return StandUse::helicopter;
+		case 'M': return StandUse::military;
+		case 'C': return StandUse::cargo;
+		default: return std::nullopt;
+		}
+	}
+
+	std::optional<StandCode> parseStandCode(std::string_view value)
+	{
+		char c = letter(value);
+		if (c < 'A' || c > 'F') return std::nullopt;
+		return static_cast<StandCode>(c - 'A' + 1);
+	}
+
+	std::optional<StandWtc> parseStandWtc(std::string_view value)
+	{
+		switch (letter(value)) {
+		case 'A': return StandWtc::any; // "A" = all categories
+		case 'L': return StandWtc::L;
+		case 'M': return StandWtc::M;
+		case 'H': return StandWtc::H;
+		case 'J': return StandWtc::J;
+		default: return std::nullopt;
+		}
+	}
+
+	char toChar(StandUse use)
+	{
+		constexpr const char chars[] = { '-', 'A', 'P', 'H', 'M', 'C' };
+		return chars[static_cast<size_t>(use)];
+	}
+
+	char toChar(StandCode code)
+	{
+		return (code == StandCode::any) ? '-' : static_cast<char>('A' + static_cast<int>(code) - 1);
+	}
+
+	char toChar(StandWtc wtc)
+	{
+		constexpr const char chars[] = { '-', 'L', 'M', 'H', 'J' };
+		return chars[static_cast<size_t>(wtc)];
+	}
+
+	std::optional<Relaxation> parseRelaxation(std::string_view value)
+	{
+		std::string name(value);
+		std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		if (name == "schengen") return Relaxation::schengen;
+		if (name == "national") return Relaxation::national;
+		if (name == "wtc") return Relaxation::wtc;
+		if (name == "use") return Relaxation::use;
+		return std::nullopt;
+	}
+
+	const char* toString(Relaxation relaxation)
+	{
+		switch (relaxation) {
+		case Relaxation::schengen: return "schengen";
+		case Relaxation::national: return "national";
+		case Relaxation::wtc: return "wtc";
+		case Relaxation::use: return "use";
+		default: return "none";
+		}
+	}
+
+	std::optional<StandId> StandTable::find(std::string_view name) const
+	{
+		auto it = ids.find(std::string(name));
+		if (it == ids.end()) return std::nullopt;
+		return it->second;
+	}
+
+	StandId StandTable::addStand(std::string_view name)
+	{
+		StandId id = static_cast<StandId>(names.size());
+		names.emplace_back(name);
+		use.push_back(StandUse::any);
+		code.push_back(StandCode::any);
+		wtc.push_back(StandWtc::any);
+		flags.push_back(0);
+		priority.push_back(0);
+		latitude.push_back(0);
+		longitude.push_back(0);
+		radius.push_back(0);
+		ids.emplace(names.back(), id);
+		return id;
+	}
+
+	void StandTable::setPosition(StandId stand, const StandPosition& position)
+	{
+		latitude[stand] = position.latitude;
+		longitude[stand] = position.longitude;
+		radius[stand] = position.radius;
+		flags[stand] |= StandFlag::hasPosition;
+	}
+
+	void StandTable::addBlock(StandId stand, std::string_view blockedName)
+	{
+		pendingBlocks_.emplace_back(stand, std::string(blockedName));
+	}
+
+	void StandTable::addAirline(StandId stand, std::string_view airline)
+	{
+		std::string code(airline);
+		std::transform(code.begin(), code.end(), code.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+		pendingAirlines_.emplace_back(stand, std::move(code));
+	}
+
+	void StandTable::addType(StandId stand, std::string_view designator)
+	{
+		pendingTypes_.emplace_back(stand, std::string(designator));
+	}
+
+	bool StandTable::addRelaxation(Relaxation relaxation)
+	{
+		if (std::find(relaxations.begin(), relaxations.end(), relaxation) != relaxations.end()) return false;
+		relaxations.push_back(relaxation);
+		return true;
+	}
+
+	bool StandTable::finalize(std::string& error)
+	{
+		if (names.size() != ids.size()) {
+			error = "Duplicate stand name in " + icao;
+			return false;
+		}
+
+		std::stable_sort(pendingBlocks_.begin(), pendingBlocks_.end(),
+			[](const auto& a, const auto& b) { return a.first < b.first; });
+
+		blockOffsets.assign(size() + 1, 0);
+		blocks.clear();
+		blocks.reserve(pendingBlocks_.size());
+
+		for (const auto& [stand, blockedName] : pendingBlocks_) {
+			std::optional<StandId> blocked = find(blockedName);
+			if (!blocked) {
+				error = "Stand " + names[stand] + " blocks unknown stand " + blockedName;
+				return false;
+			}
+			if (*blocked == stand) {
+				error = "Stand " + names[stand] + " blocks itself";
+				return false;
+			}
+			blocks.push_back(*blocked);
+			++blockOffsets[stand + 1];
+		}
+		for (size_t i = 1; i < blockOffsets.size(); ++i) {
+			blockOffsets[i] += blockOffsets[i - 1];
+		}
+
+		std::stable_sort(pendingAirlines_.begin(), pendingAirlines_.end(),
+			[](const auto& a, const auto& b) { return a.first < b.first; });
+
+		airlineOffsets.assign(size() + 1, 0);
+		airlines.clear();
+		airlines.reserve(pendingAirlines_.size());
+
+		for (auto& [stand, airline] : pendingAirlines_) {
+			if (airline.size() != 3) {
+				error = "Stand " + names[stand] + " has invalid airline code '" + airline + "'";
+				return false;
+			}
+			airlines.push_back(std::move(airline));
+			++airlineOffsets[stand + 1];
+		}
+		for (size_t i = 1; i < airlineOffsets.size(); ++i) {
+			airlineOffsets[i] += airlineOffsets[i - 1];
+		}
+
+		// A designator the aircraft database doesn't know can't match what pilots file, it is dropped
+		// rather than closing the stand to everyone
+		std::stable_sort(pendingTypes_.begin(), pendingTypes_.end(),
+			[](const auto& a, const auto& b) { return a.first < b.first; });
+
+		typeOffsets.assign(size() + 1, 0);
+		types.clear();
+		types.reserve(pendingTypes_.size());
+
+		for (const auto& [stand, designator] : pendingTypes_) {
+			std::optional<AircraftPerformance> aircraft = findAircraft(designator);
+			if (!aircraft) {
+				warnings.push_back("Stand " + names[stand] + " in " + icao + ": unknown aircraft type '" + designator + "' ignored");
+				continue;
+			}
+			types.push_back(aircraft->key);
+			++typeOffsets[stand + 1];
+		}
+		for (size_t i = 1; i < typeOffsets.size(); ++i) {
+			typeOffsets[i] += typeOffsets[i - 1];
+		}
+
+		pendingBlocks_.clear();
+		pendingBlocks_.shrink_to_fit();
+		pendingAirlines_.clear();
+		pendingAirlines_.shrink_to_fit();
+		pendingTypes_.clear();
+		pendingTypes_.shrink_to_fit();
+
+		if (!taxi.build(taxiGraph, *this, error)) return false;
+		taxiGraph = TaxiGraph{};
+
+		index.build(*this);
+		return rules.compile(*this, error);
+	}
+
+	bool compileStandTable(const nlohmann::ordered_json& config, const std::string& icao, StandTable& table, std::string& error)
+	{
+		if (!config.contains("STAND") || !config["STAND"].is_object()) {
+			error = "No STAND section in config for: " + icao;
+			return false;
+		}
+
+		const auto& standsJson = config["STAND"];
+		if (standsJson.size() > MAX_STANDS) {
+			error = "Too many stands in config for: " + icao;
+			return false;
+		}
+
+		table = StandTable{};
+		table.icao = icao;
+		if (config.contains("version")) table.version = config["version"].get<std::string>();
+
+		if (config.contains("RELAX")) {
+			for (const auto& rung : config["RELAX"]) {
+				std::optional<Relaxation> relaxation = parseRelaxation(rung.get<std::string>());
+				if (!relaxation || !table.addRelaxation(*relaxation)) {
+					error = "Invalid or repeated RELAX rung " + rung.get<std::string>() + " in config for: " + icao;
+					return false;
+				}
+			}
+		}
+
+		if (config.contains("RULES")) {
+			for (const auto& rule : config["RULES"]) {
+				table.ruleSources.push_back(rule.get<std::string>());
+			}
+		}
+
+		// "TAXI": { "NODES": { "A1": "lat:lon" }, "TAXIWAYS": [["A1", "A2", ...]], "EXITS": { "27R": ["A1"] } }
+		if (config.contains("TAXI")) {
+			const auto& taxiJson = config["TAXI"];
+			if (taxiJson.contains("NODES")) {
+				for (auto it = taxiJson["NODES"].begin(); it != taxiJson["NODES"].end(); ++it) {
+					std::optional<StandPosition> position = parseStandPosition(it.value().get<std::string>());
+					if (!position || !table.taxiGraph.addNode(it.key(), position->latitude, position->longitude)) {
+						error = "Invalid or repeated taxi node " + it.key() + " in config for: " + icao;
+						return false;
+					}
+				}
+			}
+			if (taxiJson.contains("TAXIWAYS")) {
+				for (const auto& taxiway : taxiJson["TAXIWAYS"]) {
+					for (size_t i = 1; i < taxiway.size(); ++i) {
+						table.taxiGraph.addEdge(taxiway[i - 1].get<std::string>(), taxiway[i].get<std::string>());
+					}
+				}
+			}
+			if (taxiJson.contains("EXITS")) {
+				for (auto it = taxiJson["EXITS"].begin(); it != taxiJson["EXITS"].end(); ++it) {
+					for (const auto& exit : it.value()) {
+						table.taxiGraph.addExit(it.key(), exit.get<std::string>());
+					}
+				}
+			}
+		}
+
+		for (auto it = standsJson.begin(); it != standsJson.end(); ++it) {
+			const auto& standJson = it.value();
+			StandId id = table.addStand(it.key());
+
+			if (standJson.contains("coordinates")) {
+				std::optional<StandPosition> position = parseStandPosition(standJson["coordinates"].get<std::string>());
+				if (!position) {
+					error = "Invalid coordinates for stand " + it.key();
+					return false;
+				}
+				table.setPosition(id, *position);
+			}
+
+			if (standJson.contains("use")) {
+				std::optional<StandUse> use = parseStandUse(standJson["use"].get<std::string>());
+				if (!use) {
+					error = "Invalid use for stand " + it.key();
+					return false;
+				}
+				table.use[id] = *use;
+			}
+
+			if (standJson.contains("code")) {
+				std::optional<StandCode> code = parseStandCode(standJson["code"].get<std::string>());
+				if (!code) {
+					error = "Invalid code for stand " + it.key();
+					return false;
+				}
+				table.code[id] = *code;
+			}
+
+			if (standJson.contains("WTC")) {
+				std::optional<StandWtc> wtc = parseStandWtc(standJson["WTC"].get<std::string>());
+				if (!wtc) {
+					error = "Invalid WTC for stand " + it.key();
+					return false;
+				}
+				table.wtc[id] = *wtc;
+			}
+
+			// "shengen" is the legacy spelling, still accepted
+			const char* schengenKey = standJson.contains("schengen") ? "schengen" : "shengen";
+			if (standJson.contains(schengenKey)) {
+				table.flags[id] |= StandFlag::hasSchengen;
+				if (standJson[schengenKey].get<bool>()) table.flags[id] |= StandFlag::schengen;
+			}
+
+			if (standJson.contains("national")) {
+				table.flags[id] |= StandFlag::hasNational;
+				if (standJson["national"].get<bool>()) table.flags[id] |= StandFlag::national;
+			}
+
+			if (standJson.contains("priority")) {
+				table.priority[id] = static_cast<uint8_t>(std::clamp(standJson["priority"].get<int>(), 0, UINT8_MAX));
+			}
+
+			if (standJson.contains("BLOCK")) {
+				for (const auto& blocked : standJson["BLOCK"]) {
+					table.addBlock(id, blocked.get<std::string>());
+				}
+			}
+
+			if (standJson.contains("callsign")) {
+				for (const auto& airline : standJson["callsign"]) {
+					table.addAirline(id, airline.get<std::string>());
+				}
+			}
+
+			// Restricts the stand to some aircraft types
+			if (standJson.contains("atyp")) {
+				if (standJson["atyp"].is_array()) {
+					for (const auto& type : standJson["atyp"]) {
+						table.addType(id, type.get<std::string>());
+					}
+				}
+				else {
+					// One designator or a comma separated list
+					const std::string list = standJson["atyp"].get<std::string>();
+					size_t start = 0;
+					while (start <= list.size()) {
+						const size_t end = std::min(list.find(',', start), list.size());
+						table.addType(id, list.substr(start, end - start));
+						start = end + 1;
+					}
+				}
+			}
+		}
+
+		return table.finalize(error);
+	}
+}
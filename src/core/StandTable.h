@@ -0,0 +1,147 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Coordinates.h"
+#include "StandIndex.h"
+#include "StandRules.h"
+#include "StandTaxi.h"
+#include "utils/Column.h"
+
+namespace stand
+{
+	using StandId = uint16_t;
+	constexpr const size_t MAX_STANDS = UINT16_MAX; // StandId range
+
+	// Attribute codes, 0 always means "not restricted" for the stand
+	enum class StandUse : uint8_t
+	{
+		any = 0,
+		airliner,			// A
+		generalAviation,	// P
+		helicopter,			// H
+		military,			// M
+		cargo				// C
+	};
+
+	enum class StandCode : uint8_t
+	{
+		any = 0,
+		A, B, C, D, E, F
+	};
+
+	enum class StandWtc : uint8_t
+	{
+		any = 0,
+		L, M, H, J
+	};
+
+	namespace StandFlag
+	{
+		constexpr const uint8_t hasSchengen = 1 << 0;
+		constexpr const uint8_t schengen = 1 << 1;
+		constexpr const uint8_t hasNational = 1 << 2;
+		constexpr const uint8_t national = 1 << 3;
+		constexpr const uint8_t hasPosition = 1 << 4;
+	}
+
+	// Rungs of an airport's relaxation ladder (RELAX). When no stand matches a pilot strictly,
+	// the rungs are tried in config order, each one ignoring one more stand attribute.
+	enum class Relaxation : uint8_t
+	{
+		none = 0,
+		schengen,
+		national,
+		wtc,
+		use
+	};
+
+	std::optional<StandUse> parseStandUse(std::string_view value);
+	std::optional<StandCode> parseStandCode(std::string_view value);
+	std::optional<StandWtc> parseStandWtc(std::string_view value);
+	std::optional<Relaxation> parseRelaxation(std::string_view value);
+	const char* toString(Relaxation relaxation);
+	char toChar(StandUse use);
+	char toChar(StandCode code);
+	char toChar(StandWtc wtc);
+
+	// Compiled, read-only view of an airport's stands, built once at load.
+	// Each attribute lives in its own contiguous array indexed by StandId,
+	// viewing the stand database directly when the table was decoded from one.
+	struct StandTable
+	{
+		std::string icao;
+		std::string version; // config "version" field, empty if absent
+
+		std::vector<std::string> names;
+		Column<StandUse> use;
+		Column<StandCode> code;
+		Column<StandWtc> wtc;
+		Column<uint8_t> flags; // StandFlag bits
+		Column<uint8_t> priority;
+
+		// Quantised position (see Coordinates.h), valid when StandFlag::hasPosition is set
+		Column<int32_t> latitude;
+		Column<int32_t> longitude;
+		Column<uint16_t> radius;
+
+		// BLOCK relation in CSR form: blocks of stand i are blocks[blockOffsets[i] .. blockOffsets[i + 1])
+		Column<uint32_t> blockOffsets;
+		Column<StandId> blocks;
+
+		// Preferred airlines (CALLSIGN list) in CSR form, same layout as blocks
+		Column<uint32_t> airlineOffsets;
+		std::vector<std::string> airlines;
+
+		// Aircraft types a stand is restricted to ("atyp"), as aircraftTypeKey() values, same layout as blocks.
+		// Each restricted stand becomes one rule of its own when the rules are compiled.
+		Column<uint32_t> typeOffsets;
+		Column<uint32_t> types;
+
+		// Relaxation ladder, in the order the rungs are tried, each at most once
+		std::vector<Relaxation> relaxations;
+
+		// RULES as written in the config, compiled by finalize() together with the stand types
+		std::vector<std::string> ruleSources;
+		RuleProgram rules;
+
+		// Config problems that don't stop the load (e.g. an unknown "atyp" designator), for the loader to report.
+		// Filled by finalize(), not stored in the stand database.
+		std::vector<std::string> warnings;
+
+		// TAXI graph as written in the config, turned into taxi by finalize() and then dropped
+		TaxiGraph taxiGraph;
+		TaxiDistances taxi;
+
+		std::unordered_map<std::string, StandId> ids;
+
+		// Attribute bitmaps, rebuilt by finalize() and when decoding a stand database
+		StandIndex index;
+
+		size_t size() const { return names.size(); }
+		std::optional<StandId> find(std::string_view name) const;
+
+		// Builder interface, shared by every config format
+		StandId addStand(std::string_view name);
+		void setPosition(StandId stand, const StandPosition& position);
+		void addBlock(StandId stand, std::string_view blockedName);
+		void addAirline(StandId stand, std::string_view airline);
+		void addType(StandId stand, std::string_view designator);
+		bool addRelaxation(Relaxation relaxation); // false if already on the ladder
+		bool finalize(std::string& error);
+
+	private:
+		std::vector<std::pair<StandId, std::string>> pendingBlocks_;
+		std::vector<std::pair<StandId, std::string>> pendingAirlines_;
+		std::vector<std::pair<StandId, std::string>> pendingTypes_;
+	};
+
+	bool compileStandTable(const nlohmann::ordered_json& config, const std::string& icao, StandTable& table, std::string& error);
+}
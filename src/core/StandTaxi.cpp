@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+#include "StandTable.h"
+#include "StandTaxi.h"
+
+namespace stand
+{
+	bool TaxiGraph::addNode(std::string_view name, int32_t nodeLatitude, int32_t nodeLongitude)
+	{
+		auto [it, inserted] = ids.try_emplace(std::string(name), static_cast<uint32_t>(names.size()));
+		if (!inserted) return false;
+		names.emplace_back(name);
+		latitude.push_back(nodeLatitude);
+		longitude.push_back(nodeLongitude);
+		return true;
+	}
+
+	void TaxiGraph::addEdge(std::string_view from, std::string_view to)
+	{
+		edges.emplace_back(std::string(from), std::string(to));
+	}
+
+	void TaxiGraph::addExit(std::string_view runway, std::string_view node)
+	{
+		auto it = std::find_if(exits.begin(), exits.end(), [runway](const auto& exit) { return exit.first == runway; });
+		if (it == exits.end()) it = exits.insert(exits.end(), { std::string(runway), {} });
+		it->second.emplace_back(node);
+	}
+
+	uint32_t groundMeters(int32_t latitude1, int32_t longitude1, int32_t latitude2, int32_t longitude2)
+	{
+		constexpr double METERS_PER_DEGREE = 111195.0; // mean Earth radius
+		constexpr double PI = 3.14159265358979323846;
+		const double meanLatitude = (toDegrees(latitude1) + toDegrees(latitude2)) / 2 * PI / 180;
+		const double north = (toDegrees(latitude2) - toDegrees(latitude1)) * METERS_PER_DEGREE;
+		const double east = (toDegrees(longitude2) - toDegrees(longitude1)) * METERS_PER_DEGREE * std::cos(meanLatitude);
+		return static_cast<uint32_t>(std::lround(std::sqrt(north * north + east * east)));
+	}
+
+	bool TaxiDistances::build(const TaxiGraph& graph, const StandTable& table, std::string& error)
+	{
+		clear();
+		if (graph.empty()) {
+			if (!graph.edges.empty() || !graph.exits.empty()) {
+				error = "TAXI section without nodes in config for: " + table.icao;
+				return false;
+			}
+			return true;
+		}
+
+		auto node = [&graph, &table, &error](const std::string& name) -> std::optional<uint32_t> {
+			auto it = graph.ids.find(name);
+			if (it == graph.ids.end()) {
+				error = "Unknown taxi node " + name + " in config for: " + table.icao;
+				return std::nullopt;
+			}
+			return it->second;
+		};
+
+		// Adjacency in CSR form, both directions, weighted by the straight distance between nodes
+		const size_t nodeCount = graph.names.size();
+		std::vector<std::pair<uint32_t, uint32_t>> edges;
+		edges.reserve(graph.edges.size() * 2);
+		for (const auto& [fromName, toName] : graph.edges) {
+			std::optional<uint32_t> from = node(fromName);
+			std::optional<uint32_t> to = node(toName);
+			if (!from || !to) return false;
+			edges.emplace_back(*from, *to);
+			edges.emplace_back(*to, *from);
+		}
+		std::sort(edges.begin(), edges.end());
+		std::vector<uint32_t> offsets(nodeCount + 1, 0);
+		std::vector<uint32_t> targets;
+		std::vector<uint32_t> weights;
+		targets.reserve(edges.size());
+		weights.reserve(edges.size());
+		for (const auto& [from, to] : edges) {
+			++offsets[from + 1];
+			targets.push_back(to);
+			weights.push_back(groundMeters(graph.latitude[from], graph.longitude[from], graph.latitude[to], graph.longitude[to]));
+		}
+		for (size_t i = 1; i < offsets.size(); ++i) offsets[i] += offsets[i - 1];
+
+		// Each positioned stand joins the graph at its closest node
+		std::vector<uint32_t> standNode(table.size(), 0);
+		std::vector<uint32_t> standLink(table.size(), UNREACHABLE);
+		for (size_t stand = 0; stand < table.size(); ++stand) {
+			if (!(table.flags[stand] & StandFlag::hasPosition)) continue;
+			for (uint32_t n = 0; n < nodeCount; ++n) {
+				const uint32_t meters = groundMeters(table.latitude[stand], table.longitude[stand], graph.latitude[n], graph.longitude[n]);
+				if (meters < standLink[stand]) {
+					standLink[stand] = meters;
+					standNode[stand] = n;
+				}
+			}
+		}
+
+		standCount_ = table.size();
+		std::vector<uint32_t> matrix(graph.exits.size() * standCount_, UNREACHABLE);
+		std::vector<uint32_t> distance(nodeCount);
+		using Entry = std::pair<uint32_t, uint32_t>; // distance, node
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+		for (size_t runway = 0; runway < graph.exits.size(); ++runway) {
+			const auto& [name, exitNodes] = graph.exits[runway];
+			std::fill(distance.begin(), distance.end(), UNREACHABLE);
+			for (const std::string& exitName : exitNodes) {
+				std::optional<uint32_t> exit = node(exitName);
+				if (!exit) return false;
+				distance[*exit] = 0;
+				queue.emplace(0, *exit);
+			}
+
+			while (!queue.empty()) {
+				const auto [meters, current] = queue.top();
+				queue.pop();
+				if (meters > distance[current]) continue;
+				for (uint32_t e = offsets[current]; e < offsets[current + 1]; ++e) {
+					const uint32_t next = meters + weights[e];
+					if (next < distance[targets[e]]) {
+						distance[targets[e]] = next;
+						queue.emplace(next, targets[e]);
+					}
+				}
+			}
+
+			uint32_t* row = matrix.data() + runway * standCount_;
+			for (size_t stand = 0; stand < standCount_; ++stand) {
+				if (standLink[stand] == UNREACHABLE || distance[standNode[stand]] == UNREACHABLE) continue;
+				row[stand] = distance[standNode[stand]] + standLink[stand];
+			}
+			runways_.push_back(name);
+		}
+		meters_ = std::move(matrix);
+		return true;
+	}
+
+	void TaxiDistances::assign(std::vector<std::string> runways, Column<uint32_t> meters, size_t standCount)
+	{
+		runways_ = std::move(runways);
+		meters_ = std::move(meters);
+		standCount_ = standCount;
+	}
+
+	void TaxiDistances::clear()
+	{
+		runways_.clear();
+		meters_.clear();
+		standCount_ = 0;
+	}
+
+	std::optional<size_t> TaxiDistances::findRunway(std::string_view runway) const
+	{
+		auto it = std::find(runways_.begin(), runways_.end(), runway);
+		if (it == runways_.end()) return std::nullopt;
+		return static_cast<size_t>(it - runways_.begin());
+	}
+
+	std::vector<uint32_t> TaxiDistances::closest(const std::vector<std::string>& runways) const
+	{
+		std::vector<uint32_t> result;
+		for (const std::string& name : runways) {
+			std::optional<size_t> runway = findRunway(name);
+			if (!runway) continue;
+			const uint32_t* meters = row(*runway);
+			if (result.empty()) {
+				result.assign(meters, meters + standCount_);
+				continue;
+			}
+			for (size_t stand = 0; stand < standCount_; ++stand) result[stand] = std::min(result[stand], meters[stand]);
+		}
+		return result;
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Coordinates.h"
+#include "utils/Column.h"
+
+namespace stand
+{
+	struct StandTable;
+	using StandId = uint16_t;
+
+	constexpr const uint32_t TAXI_TOLERANCE = 300; // Stands less than this further than the closest candidate count as equally close (in meters)
+
+	// Optional taxiway graph of an airport (TAXI), as read from the config.
+	// Nodes are named points, taxiways chain nodes together, each runway lists the nodes
+	// its arrivals vacate onto. A stand joins the graph at the node closest to it.
+	// Only used to compute TaxiDistances, it is not kept once the table is finalized.
+	struct TaxiGraph
+	{
+		std::vector<std::string> names;
+		std::vector<int32_t> latitude;
+		std::vector<int32_t> longitude;
+		std::unordered_map<std::string, uint32_t> ids;
+
+		std::vector<std::pair<std::string, std::string>> edges;            // by node name, resolved when built
+		std::vector<std::pair<std::string, std::vector<std::string>>> exits; // runway -> exit nodes, in config order
+
+		bool empty() const { return names.empty(); }
+		bool addNode(std::string_view name, int32_t nodeLatitude, int32_t nodeLongitude); // false if already defined
+		void addEdge(std::string_view from, std::string_view to);
+		void addExit(std::string_view runway, std::string_view node);
+	};
+
+	// Shortest taxi distance from each runway's exits to every stand, as a dense
+	// runways x stands matrix of meters computed once at load (one multi-source Dijkstra per runway).
+	// Scoring a stand for the active runway is then a single array lookup.
+	class TaxiDistances
+	{
+	public:
+		static constexpr const uint32_t UNREACHABLE = UINT32_MAX; // stand without position, or not connected to the runway
+
+		bool build(const TaxiGraph& graph, const StandTable& table, std::string& error);
+		// Decoded matrix, meters.size() must be runways.size() * standCount
+		void assign(std::vector<std::string> runways, Column<uint32_t> meters, size_t standCount);
+		void clear();
+
+		bool empty() const { return runways_.empty(); }
+		size_t standCount() const { return standCount_; }
+		const std::vector<std::string>& runways() const { return runways_; }
+		const Column<uint32_t>& matrix() const { return meters_; }
+		std::optional<size_t> findRunway(std::string_view runway) const;
+
+		const uint32_t* row(size_t runway) const { return meters_.data() + runway * standCount_; }
+		uint32_t meters(size_t runway, StandId stand) const { return meters_[runway * standCount_ + stand]; }
+
+		// Per stand, the shortest distance from any of the given runways the graph knows.
+		// Empty when it knows none of them.
+		std::vector<uint32_t> closest(const std::vector<std::string>& runways) const;
+
+	private:
+		std::vector<std::string> runways_;
+		Column<uint32_t> meters_;
+		size_t standCount_ = 0;
+	};
+
+	// Ground distance between two quantised positions (equirectangular, fine at airport scale)
+	uint32_t groundMeters(int32_t latitude1, int32_t longitude1, int32_t latitude2, int32_t longitude2);
+}
@@ -0,0 +1,217 @@
+#include <charconv>
+
+#include "StandTextParser.h"
+
+namespace stand
+{
+	namespace
+	{
+		std::string_view trim(std::string_view value)
+		{
+			while (!value.empty() && (value.front() == ' ' || value.front() == '\t' || value.front() == '\r')) value.remove_prefix(1);
+			while (!value.empty() && (value.back() == ' ' || value.back() == '\t' || value.back() == '\r')) value.remove_suffix(1);
+			return value;
+		}
+
+		// Returns the text up to the next separator and advances past it
+		std::string_view nextField(std::string_view& rest, char separator = ':')
+		{
+			size_t pos = rest.find(separator);
+			std::string_view field = rest.substr(0, pos);
+			rest = (pos == std::string_view::npos) ? std::string_view{} : rest.substr(pos + 1);
+			return trim(field);
+		}
+
+		bool parseInt(std::string_view value, int& out)
+		{
+			if (!value.empty() && value.front() == '+') value.remove_prefix(1);
+			auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), out);
+			return ec == std::errc() && ptr == value.data() + value.size();
+		}
+
+		std::string lineError(size_t lineNumber, const std::string& message)
+		{
+			return "line " + std::to_string(lineNumber) + ": " + message;
+		}
+	}
+
+	bool isStandTextFormat(std::string_view content)
+	{
+		if (content.starts_with("\xEF\xBB\xBF")) content.remove_prefix(3); // UTF-8 BOM
+		size_t first = content.find_first_not_of(" \t\r\n");
+		return first != std::string_view::npos && content[first] != '{';
+	}
+
+	bool parseStandText(std::string_view text, const std::string& icao, StandTable& table, std::string& error)
+	{
+		table = StandTable{};
+		table.icao = icao;
+
+		bool inStand = false; // false while skipping a stand from another airport
+		StandId current = 0;
+		size_t lineNumber = 0;
+
+		while (!text.empty()) {
+			size_t end = text.find('\n');
+			std::string_view line = trim(text.substr(0, end));
+			text = (end == std::string_view::npos) ? std::string_view{} : text.substr(end + 1);
+			++lineNumber;
+
+			if (line.empty() || line.front() == ';' || line.starts_with("//")) continue;
+
+			std::string_view rest = line;
+			std::string_view keyword = nextField(rest);
+
+			// Airport wide, RELAX:<ICAO>:<rung>,<rung>...
+			if (keyword == "RELAX") {
+				if (nextField(rest) != icao) continue;
+				while (!rest.empty()) {
+					std::string_view rung = nextField(rest, ',');
+					if (rung.empty()) continue;
+					std::optional<Relaxation> relaxation = parseRelaxation(rung);
+					if (!relaxation || !table.addRelaxation(*relaxation)) {
+						error = lineError(lineNumber, "invalid or repeated RELAX rung " + std::string(rung));
+						return false;
+					}
+				}
+				continue;
+			}
+
+			// Airport wide, RULE:<ICAO>:<stands> REQUIRE <condition>
+			if (keyword == "RULE") {
+				if (nextField(rest) == icao) table.ruleSources.emplace_back(trim(rest));
+				continue;
+			}
+
+			// Airport wide taxiway graph:
+			//   TAXINODE:<ICAO>:<node>:<lat>:<lon>
+			//   TAXIWAY:<ICAO>:<node>,<node>...   (consecutive nodes are connected)
+			//   RWYEXIT:<ICAO>:<runway>:<node>,<node>...
+			if (keyword == "TAXINODE") {
+				if (nextField(rest) != icao) continue;
+				std::string_view node = nextField(rest);
+				std::optional<StandPosition> position = parseStandPosition(rest);
+				if (node.empty() || !position || !table.taxiGraph.addNode(node, position->latitude, position->longitude)) {
+					error = lineError(lineNumber, "invalid or repeated TAXINODE " + std::string(node));
+					return false;
+				}
+				continue;
+			}
+
+			if (keyword == "TAXIWAY") {
+				if (nextField(rest) != icao) continue;
+				std::string_view previous;
+				while (!rest.empty()) {
+					std::string_view node = nextField(rest, ',');
+					if (node.empty()) continue;
+					if (!previous.empty()) table.taxiGraph.addEdge(previous, node);
+					previous = node;
+				}
+				continue;
+			}
+
+			if (keyword == "RWYEXIT") {
+				if (nextField(rest) != icao) continue;
+				std::string_view runway = nextField(rest);
+				while (!rest.empty()) {
+					std::string_view node = nextField(rest, ',');
+					if (!node.empty()) table.taxiGraph.addExit(runway, node);
+				}
+				continue;
+			}
+
+			if (keyword == "STAND") {
+				std::string_view standIcao = nextField(rest);
+				std::string_view name = nextField(rest);
+				inStand = (standIcao == icao);
+				if (!inStand) continue;
+
+				if (name.empty()) {
+					error = lineError(lineNumber, "missing stand name");
+					return false;
+				}
+				// Exports may list a stand several times (alternate positions), first definition wins
+				if (table.find(name)) {
+					inStand = false;
+					continue;
+				}
+				if (table.size() >= MAX_STANDS) {
+					error = "Too many stands in config for: " + icao;
+					return false;
+				}
+				current = table.addStand(name);
+
+				if (!rest.empty()) {
+					std::optional<StandPosition> position = parseStandPosition(rest);
+					if (!position) {
+						error = lineError(lineNumber, "invalid coordinates for stand " + table.names[current]);
+						return false;
+					}
+					table.setPosition(current, *position);
+				}
+				continue;
+			}
+
+			if (!inStand) continue;
+
+			if (keyword == "USE") {
+				std::optional<StandUse> use = parseStandUse(nextField(rest));
+				if (!use) {
+					error = lineError(lineNumber, "invalid USE for stand " + table.names[current]);
+					return false;
+				}
+				table.use[current] = *use;
+			}
+			else if (keyword == "CODE") {
+				std::optional<StandCode> code = parseStandCode(nextField(rest));
+				if (!code) {
+					error = lineError(lineNumber, "invalid CODE for stand " + table.names[current]);
+					return false;
+				}
+				table.code[current] = *code;
+			}
+			else if (keyword == "WTC") {
+				std::optional<StandWtc> wtc = parseStandWtc(nextField(rest));
+				if (!wtc) {
+					error = lineError(lineNumber, "invalid WTC for stand " + table.names[current]);
+					return false;
+				}
+				table.wtc[current] = *wtc;
+			}
+			else if (keyword == "SCHENGEN" || keyword == "NON-SCHENGEN") {
+				table.flags[current] |= StandFlag::hasSchengen;
+				if (keyword == "SCHENGEN") table.flags[current] |= StandFlag::schengen;
+			}
+			else if (keyword == "NATIONAL" || keyword == "NON-NATIONAL") {
+				table.flags[current] |= StandFlag::hasNational;
+				if (keyword == "NATIONAL") table.flags[current] |= StandFlag::national;
+			}
+			else if (keyword == "PRIORITY") {
+				int priority = 0;
+				if (!parseInt(nextField(rest), priority) || priority < 0 || priority > UINT8_MAX) {
+					error = lineError(lineNumber, "invalid PRIORITY for stand " + table.names[current]);
+					return false;
+				}
+				table.priority[current] = static_cast<uint8_t>(priority);
+			}
+			else if (keyword == "CALLSIGN") {
+				while (!rest.empty()) {
+					std::string_view airline = nextField(rest, ',');
+					if (!airline.empty()) table.addAirline(current, airline);
+				}
+			}
+			else if (keyword == "BLOCK" || keyword == "BLOCKS") {
+				while (!rest.empty()) {
+					std::string_view blocked = nextField(rest, ',');
+					if (!blocked.empty()) table.addBlock(current, blocked);
+				}
+			}
+		}
+
+		if (table.size() == 0) {
+			error = "No STAND for " + icao + " in config";
+			return false;
+		}
+		return table.finalize(error);
+	}
+}
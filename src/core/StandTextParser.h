@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+#include "StandTable.h"
+
+namespace stand
+{
+	// Single pass parser for the line based EuroScope/GRplugin stand format:
+	//
+	//   STAND:LFPG:A01:48.999836:2.560711:25
+	//   USE:A
+	//   NON-SCHENGEN
+	//   CALLSIGN:AFR,DAH
+	//   CODE:E
+	//   PRIORITY:+1
+	//
+	// Fields are sliced out of the input with string_view and numbers read with
+	// from_chars, stands are written straight into the table. Unknown keywords are skipped.
+	bool parseStandText(std::string_view text, const std::string& icao, StandTable& table, std::string& error);
+
+	// True when the content looks like the text format rather than JSON
+	bool isStandTextFormat(std::string_view content);
+}
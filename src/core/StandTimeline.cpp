@@ -0,0 +1,76 @@
+#include <algorithm>
+
+#include "StandTimeline.h"
+
+namespace stand
+{
+	void StandTimeline::reset(size_t standCount)
+	{
+		stands_.assign(standCount, Stand{});
+	}
+
+	void StandTimeline::rebuildMaxEnd(Stand& stand)
+	{
+		stand.maxEnd.resize(stand.reservations.size());
+		TimePoint running = INT64_MIN;
+		for (size_t i = 0; i < stand.reservations.size(); ++i) {
+			running = std::max(running, stand.reservations[i].end);
+			stand.maxEnd[i] = running;
+		}
+	}
+
+	void StandTimeline::reserve(StandId id, TimePoint start, TimePoint end, uint32_t holder)
+	{
+		Stand& stand = stands_[id];
+		auto it = std::upper_bound(stand.reservations.begin(), stand.reservations.end(), start,
+			[](TimePoint value, const Reservation& r) { return value < r.start; });
+		stand.reservations.insert(it, Reservation{ start, end, holder });
+		rebuildMaxEnd(stand);
+	}
+
+	void StandTimeline::release(StandId id, uint32_t holder)
+	{
+		Stand& stand = stands_[id];
+		std::erase_if(stand.reservations, [holder](const Reservation& r) { return r.holder == holder; });
+		rebuildMaxEnd(stand);
+	}
+
+	void StandTimeline::extend(StandId id, uint32_t holder, TimePoint until)
+	{
+		Stand& stand = stands_[id];
+		bool changed = false;
+		for (auto& reservation : stand.reservations) {
+			if (reservation.holder == holder && reservation.end < until) {
+				reservation.end = until;
+				changed = true;
+			}
+		}
+		if (changed) rebuildMaxEnd(stand);
+	}
+
+	bool StandTimeline::isFree(StandId id, TimePoint start, TimePoint end) const
+	{
+		const Stand& stand = stands_[id];
+		// Last reservation starting before the window ends, the running max tells whether any of them reaches into it
+		auto it = std::lower_bound(stand.reservations.begin(), stand.reservations.end(), end,
+			[](const Reservation& r, TimePoint value) { return r.start < value; });
+		if (it == stand.reservations.begin()) return true;
+		return stand.maxEnd[(it - stand.reservations.begin()) - 1] <= start;
+	}
+
+	void StandTimeline::holdersStarting(StandId id, TimePoint start, TimePoint end, std::vector<uint32_t>& out) const
+	{
+		const Stand& stand = stands_[id];
+		auto it = std::lower_bound(stand.reservations.begin(), stand.reservations.end(), start,
+			[](const Reservation& r, TimePoint value) { return r.start < value; });
+		for (; it != stand.reservations.end() && it->start < end; ++it) out.push_back(it->holder);
+	}
+
+	void StandTimeline::freeDuring(const StandBitset& held, TimePoint start, TimePoint end, StandBitset& out) const
+	{
+		out.resize(held.size());
+		held.forEach([&](size_t id) {
+			if (id < stands_.size() && isFree(static_cast<StandId>(id), start, end)) out.set(id);
+		});
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "StandIndex.h"
+#include "StandTable.h"
+
+namespace stand
+{
+	using TimePoint = int64_t; // seconds since the Unix epoch
+
+	struct Reservation
+	{
+		TimePoint start;
+		TimePoint end;   // exclusive
+		uint32_t holder; // interned callsign of the pilot holding the stand
+	};
+
+	// Reservations of every stand of an airport, kept sorted by start time together
+	// with the running maximum of their end times, so "is stand X free between
+	// 14:05 and 15:10" is one binary search even when a block and an occupation overlap.
+	class StandTimeline
+	{
+	public:
+		void reset(size_t standCount);
+		size_t size() const { return stands_.size(); }
+
+		void reserve(StandId id, TimePoint start, TimePoint end, uint32_t holder);
+		void release(StandId id, uint32_t holder);
+		// Pushes the end of the holder's reservation to at least until
+		void extend(StandId id, uint32_t holder, TimePoint until);
+
+		bool isFree(StandId id, TimePoint start, TimePoint end) const;
+		// Appends the holders of the reservations starting in [start, end)
+		void holdersStarting(StandId id, TimePoint start, TimePoint end, std::vector<uint32_t>& out) const;
+
+		// out = the stands of held that have no reservation overlapping [start, end)
+		void freeDuring(const StandBitset& held, TimePoint start, TimePoint end, StandBitset& out) const;
+
+		const std::vector<Reservation>& reservations(StandId id) const { return stands_[id].reservations; }
+
+	private:
+		struct Stand
+		{
+			std::vector<Reservation> reservations; // sorted by start
+			std::vector<TimePoint> maxEnd;         // maxEnd[i] = max end of reservations[0..i]
+		};
+		static void rebuildMaxEnd(Stand& stand);
+
+		std::vector<Stand> stands_;
+	};
+
+	// Expected time on stand for an aircraft of the given code letter, in seconds
+	constexpr TimePoint turnaroundFor(StandCode code)
+	{
+		switch (code) {
+		case StandCode::A: case StandCode::B: return 30 * 60;
+		case StandCode::C: return 50 * 60;
+		case StandCode::D: case StandCode::E: return 90 * 60;
+		case StandCode::F: return 120 * 60;
+		default: return 60 * 60;
+		}
+	}
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace stand
+{
+	// One attribute array of a table: either owns its values, or views values kept alive by
+	// a shared owner (e.g. a mapped stand database), so loading doesn't copy them.
+	// Reading is the same either way. Writing to a view first copies it into an owned array.
+	template <typename T>
+	class Column
+	{
+	public:
+		using value_type = T;
+
+		Column() = default;
+		Column(std::vector<T> values) : owned_(std::move(values)) { pointAtOwned(); }
+		Column(std::initializer_list<T> values) : owned_(values) { pointAtOwned(); }
+
+		// size values at data, valid as long as owner lives
+		static Column view(const T* data, size_t size, std::shared_ptr<const void> owner)
+		{
+			Column column;
+			column.data_ = data;
+			column.size_ = size;
+			column.owner_ = std::move(owner);
+			return column;
+		}
+
+		Column(const Column& other) : owned_(other.owned_), owner_(other.owner_) { pointLike(other); }
+		Column(Column&& other) noexcept : owned_(std::move(other.owned_)), owner_(std::move(other.owner_))
+		{
+			pointLike(other);
+			other.clear();
+		}
+		Column& operator=(const Column& other)
+		{
+			if (this != &other) {
+				owned_ = other.owned_;
+				owner_ = other.owner_;
+				pointLike(other);
+			}
+			return *this;
+		}
+		Column& operator=(Column&& other) noexcept
+		{
+			if (this != &other) {
+				owned_ = std::move(other.owned_);
+				owner_ = std::move(other.owner_);
+				pointLike(other);
+				other.clear();
+			}
+			return *this;
+		}
+
+		bool isView() const { return owner_ != nullptr; }
+		size_t size() const { return size_; }
+		bool empty() const { return size_ == 0; }
+		const T* data() const { return data_; }
+		const T* begin() const { return data_; }
+		const T* end() const { return data_ + size_; }
+		const T& operator[](size_t index) const { return data_[index]; }
+		const T& back() const { return data_[size_ - 1]; }
+
+		T& operator[](size_t index)
+		{
+			detach();
+			return owned_[index];
+		}
+		void push_back(const T& value)
+		{
+			detach();
+			owned_.push_back(value);
+			pointAtOwned();
+		}
+		void assign(size_t count, const T& value)
+		{
+			owner_.reset();
+			owned_.assign(count, value);
+			pointAtOwned();
+		}
+		template <typename It>
+		void assign(It first, It last)
+		{
+			owner_.reset();
+			owned_.assign(first, last);
+			pointAtOwned();
+		}
+		void reserve(size_t count)
+		{
+			detach();
+			owned_.reserve(count);
+			pointAtOwned();
+		}
+		void clear()
+		{
+			owner_.reset();
+			owned_.clear();
+			pointAtOwned();
+		}
+
+		friend bool operator==(const Column& a, const Column& b)
+		{
+			return std::equal(a.begin(), a.end(), b.begin(), b.end());
+		}
+
+	private:
+		void pointAtOwned()
+		{
+			data_ = owned_.data();
+			size_ = owned_.size();
+		}
+		void pointLike(const Column& other)
+		{
+			if (owner_) {
+				data_ = other.data_;
+				size_ = other.size_;
+			}
+			else {
+				pointAtOwned();
+			}
+		}
+		void detach()
+		{
+			if (!owner_) return;
+			owned_.assign(data_, data_ + size_);
+			owner_.reset();
+			pointAtOwned();
+		}
+
+		std::vector<T> owned_;
+		const T* data_ = nullptr;
+		size_t size_ = 0;
+		std::shared_ptr<const void> owner_;
+	};
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace stand
+{
+	using InternId = uint32_t;
+	constexpr const InternId NO_INTERN_ID = 0; // the empty string
+
+	// Session-wide pool mapping ICAO codes, callsigns, airline prefixes and stand
+	// names to small integer IDs. Strings are never released, IDs stay valid for
+	// the whole session and references returned by str() never move.
+	class InternPool
+	{
+	public:
+		static InternPool& instance()
+		{
+			static InternPool pool;
+			return pool;
+		}
+
+		InternId intern(std::string_view value)
+		{
+			if (value.empty()) return NO_INTERN_ID;
+			{
+				std::shared_lock lock(mutex_);
+				auto it = ids_.find(value);
+				if (it != ids_.end()) return it->second;
+			}
+
+			std::unique_lock lock(mutex_);
+			auto it = ids_.find(value);
+			if (it != ids_.end()) return it->second;
+
+			InternId id = static_cast<InternId>(strings_.size());
+			const std::string& stored = strings_.emplace_back(value);
+			ids_.emplace(stored, id);
+			return id;
+		}
+
+		// Lookup without inserting, NO_INTERN_ID when the string was never interned
+		InternId find(std::string_view value) const
+		{
+			std::shared_lock lock(mutex_);
+			auto it = ids_.find(value);
+			return (it != ids_.end()) ? it->second : NO_INTERN_ID;
+		}
+
+		const std::string& str(InternId id) const
+		{
+			std::shared_lock lock(mutex_);
+			return (id < strings_.size()) ? strings_[id] : strings_[NO_INTERN_ID];
+		}
+
+		size_t size() const
+		{
+			std::shared_lock lock(mutex_);
+			return strings_.size();
+		}
+
+	private:
+		InternPool() { strings_.emplace_back(); }
+
+		mutable std::shared_mutex mutex_;
+		std::deque<std::string> strings_;                    // deque: stable addresses for the views below
+		std::unordered_map<std::string_view, InternId> ids_;
+	};
+
+	inline InternId intern(std::string_view value) { return InternPool::instance().intern(value); }
+	inline const std::string& str(InternId id) { return InternPool::instance().str(id); }
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace stand
+{
+	// Values stored densely (iteration is a plain vector walk) behind stable handles.
+	// Insert, erase and lookup by handle are O(1): erase moves the last value into the
+	// hole and fixes its slot. A handle carries its slot's generation, so a handle to an
+	// erased value never reaches whatever reuses the slot later.
+	// Not thread safe, the owner guards it.
+	template <typename T>
+	class SlotMap
+	{
+	public:
+		struct Handle
+		{
+			uint32_t slot = 0;
+			uint32_t generation = 0; // 0 = null handle, live generations start at 1
+
+			explicit operator bool() const { return generation != 0; }
+			bool operator==(const Handle&) const = default;
+		};
+
+		Handle insert(T value)
+		{
+			uint32_t slot;
+			if (!freeSlots_.empty()) {
+				slot = freeSlots_.back();
+				freeSlots_.pop_back();
+			}
+			else {
+				slot = static_cast<uint32_t>(slots_.size());
+				slots_.push_back({ 0, 1 });
+			}
+			slots_[slot].dense = static_cast<uint32_t>(values_.size());
+			values_.push_back(std::move(value));
+			denseSlots_.push_back(slot);
+			return { slot, slots_[slot].generation };
+		}
+
+		bool erase(Handle handle)
+		{
+			if (!contains(handle)) return false;
+			const uint32_t dense = slots_[handle.slot].dense;
+			if (dense + 1 != values_.size()) {
+				values_[dense] = std::move(values_.back());
+				denseSlots_[dense] = denseSlots_.back();
+				slots_[denseSlots_[dense]].dense = dense;
+			}
+			values_.pop_back();
+			denseSlots_.pop_back();
+			retire(handle.slot);
+			return true;
+		}
+
+		bool contains(Handle handle) const
+		{
+			return handle.slot < slots_.size() && handle.generation != 0 && slots_[handle.slot].generation == handle.generation;
+		}
+
+		// nullptr when the handle is stale
+		T* get(Handle handle) { return contains(handle) ? &values_[slots_[handle.slot].dense] : nullptr; }
+		const T* get(Handle handle) const { return contains(handle) ? &values_[slots_[handle.slot].dense] : nullptr; }
+
+		// Handles held before stay invalid, slots are reused
+		void clear()
+		{
+			for (uint32_t slot : denseSlots_) retire(slot);
+			values_.clear();
+			denseSlots_.clear();
+		}
+
+		size_t size() const { return values_.size(); }
+		bool empty() const { return values_.empty(); }
+
+		// Dense iteration, order changes on erase
+		auto begin() { return values_.begin(); }
+		auto end() { return values_.end(); }
+		auto begin() const { return values_.begin(); }
+		auto end() const { return values_.end(); }
+
+	private:
+		struct Slot
+		{
+			uint32_t dense;      // index in values_ while live
+			uint32_t generation; // bumped on erase
+		};
+
+		void retire(uint32_t slot)
+		{
+			if (++slots_[slot].generation == 0) slots_[slot].generation = 1;
+			freeSlots_.push_back(slot);
+		}
+
+		std::vector<T> values_;
+		std::vector<uint32_t> denseSlots_; // slot of each value
+		std::vector<Slot> slots_;
+		std::vector<uint32_t> freeSlots_;
+	};
+}
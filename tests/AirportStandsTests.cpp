@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "core/AirportStands.h"
+
+namespace {
+    using stand::intern;
+
+    // A1 A2 B1, A1 blocks A2
+    stand::StandTable table(std::initializer_list<const char*> names = { "A1", "A2", "B1" })
+    {
+        stand::StandTable result;
+        result.icao = "TEST";
+        for (const char* name : names) result.addStand(name);
+        if (result.find("A1") && result.find("A2")) result.addBlock(*result.find("A1"), "A2");
+        std::string error;
+        result.finalize(error);
+        return result;
+    }
+
+    void hold(stand::AirportStands& stands, const stand::StandTable& table, const char* callsign, const char* name,
+        stand::TimePoint from, stand::TimePoint until)
+    {
+        stands.hold(intern(callsign), intern(name), *table.find(name), from, until);
+    }
+}
+
+TEST_CASE(airportStandsHoldAndRelease)
+{
+    const stand::StandTable airport = table();
+    stand::AirportStands stands;
+    stands.follow(airport);
+    const stand::StandId a1 = *airport.find("A1");
+    const stand::StandId a2 = *airport.find("A2");
+
+    hold(stands, airport, "AFR1", "A1", 0, 1000);
+    CHECK(stands.occupancy().occupied().test(a1));
+    CHECK(stands.occupancy().blocked().test(a2));
+    CHECK(!stands.timeline().isFree(a2, 500, 600)); // blocks are reserved for the same window
+
+    // Holding another stand replaces the first one
+    hold(stands, airport, "AFR1", "B1", 0, 1000);
+    CHECK(stands.stays().size() == 1);
+    CHECK(!stands.occupancy().occupied().test(a1));
+    CHECK(!stands.occupancy().blocked().test(a2));
+    CHECK(stands.timeline().isFree(a2, 0, 1000));
+
+    CHECK(stands.release(intern("AFR1")));
+    CHECK(!stands.release(intern("AFR1")));
+    CHECK(stands.stays().empty());
+}
+
+TEST_CASE(airportStandsFollowRemapsByName)
+{
+    stand::AirportStands stands;
+    const stand::StandTable before = table();
+    stands.follow(before);
+    hold(stands, before, "AFR1", "A1", 0, 1000);
+    hold(stands, before, "BAW2", "B1", 0, 1000);
+
+    // B1 is gone and A1 moved, its BLOCK list comes from the new table
+    const stand::StandTable after = table({ "C1", "A2", "A1" });
+    REQUIRE(after.index.epoch != before.index.epoch);
+    const std::vector<stand::InternId> dropped = stands.follow(after);
+    CHECK(dropped == std::vector<stand::InternId>({ intern("BAW2") }));
+    CHECK(stands.tableEpoch() == after.index.epoch);
+    REQUIRE(stands.stays().size() == 1);
+    CHECK(stands.stays().at(intern("AFR1")).id == *after.find("A1"));
+    CHECK(stands.occupancy().occupied().test(*after.find("A1")));
+    CHECK(stands.occupancy().blocked().test(*after.find("A2")));
+    CHECK(!stands.timeline().isFree(*after.find("A2"), 0, 1000));
+}
+
+TEST_CASE(airportStandsExtendStays)
+{
+    const stand::StandTable airport = table();
+    stand::AirportStands stands;
+    stands.follow(airport);
+    const stand::StandId b1 = *airport.find("B1");
+    hold(stands, airport, "AFR1", "B1", 0, 1000);
+    hold(stands, airport, "BAW2", "A1", 0, 5000);
+
+    CHECK(stands.extendStays(2000).empty());
+    CHECK(stands.stays().at(intern("AFR1")).until == 2000);
+    CHECK(stands.stays().at(intern("BAW2")).until == 5000); // never shortened
+    CHECK(!stands.timeline().isFree(b1, 1500, 1600));
+    CHECK(stands.timeline().isFree(b1, 2000, 3000));
+}
+
+TEST_CASE(airportStandsOverstayDisplacesLaterArrivals)
+{
+    const stand::StandTable airport = table();
+    stand::AirportStands stands;
+    stands.follow(airport);
+    const stand::StandId a1 = *airport.find("A1");
+    const stand::StandId a2 = *airport.find("A2");
+
+    // AFR1 is on A1 (blocking A2) until 1000, the next arrivals were given A1 and A2 right after
+    hold(stands, airport, "AFR1", "A1", 0, 1000);
+    hold(stands, airport, "BAW2", "A1", 1500, 3000);
+    hold(stands, airport, "DLH3", "A2", 1200, 1400);
+    hold(stands, airport, "EZY4", "B1", 1100, 2000);
+
+    // Still connected at 1600: both later arrivals lose their stand, EZY4 on B1 is not in the way
+    std::vector<stand::InternId> displaced = stands.extendStays(1600);
+    std::vector<stand::InternId> expected = { intern("BAW2"), intern("DLH3") };
+    std::sort(expected.begin(), expected.end());
+    CHECK(displaced == expected);
+
+    CHECK(stands.stays().size() == 2);
+    CHECK(stands.stays().contains(intern("AFR1")));
+    CHECK(stands.stays().contains(intern("EZY4")));
+    CHECK(stands.stays().at(intern("AFR1")).until == 1600);
+    CHECK(stands.timeline().reservations(a1).size() == 1);
+    CHECK(!stands.timeline().isFree(a1, 1500, 1600));
+    CHECK(stands.timeline().isFree(a1, 1600, 3000));
+    CHECK(!stands.timeline().isFree(a2, 1500, 1600));
+    CHECK(stands.occupancy().occupied().count() == 2);
+
+    // Given back to the timeline, a new pick for BAW2 can't land on A1 before AFR1 leaves
+    CHECK(!stands.fits(a1, 1500, stand::StandCode::C));
+    CHECK(stands.fits(a1, 1600, stand::StandCode::C));
+}
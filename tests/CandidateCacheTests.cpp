@@ -0,0 +1,188 @@
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "Check.h"
+#include "core/AircraftDatabase.h"
+#include "core/CandidateCache.h"
+#include "core/StandOccupancy.h"
+
+namespace {
+    // A1 lists AFR, A2 takes anyone
+    const char* CONFIG = R"({ "STAND": {
+        "A1": { "use": "A", "callsign": ["AFR"] },
+        "A2": { "use": "A" }
+    } })";
+
+    stand::StandTable compile(const char* config = CONFIG)
+    {
+        stand::StandTable table;
+        std::string error;
+        stand::compileStandTable(nlohmann::ordered_json::parse(config), "TEST", table, error);
+        return table;
+    }
+
+    stand::StandRequest request(std::string_view airline = "", std::string_view type = "")
+    {
+        stand::StandRequest result;
+        result.use = stand::StandUse::airliner;
+        result.code = stand::StandCode::C;
+        result.airline = airline.empty() ? 0 : stand::airlineKey(airline);
+        result.aircraftType = type.empty() ? 0 : stand::aircraftTypeKey(type);
+        return result;
+    }
+
+    std::string names(const stand::StandTable& table, const stand::StandBitset& stands)
+    {
+        std::string result;
+        stands.forEach([&](size_t id) { result += (result.empty() ? "" : " ") + table.names[id]; });
+        return result;
+    }
+}
+
+TEST_CASE(cacheMemoisesProfiles)
+{
+    const stand::StandTable table = compile();
+    stand::CandidateCache cache;
+
+    const stand::CandidateProfile& afr = cache.profile(table, request("AFR123"));
+    CHECK(afr.hasAirline);
+    CHECK(names(table, afr.attributes) == "A1 A2");
+    CHECK(names(table, afr.preferred) == "A1");
+    CHECK(cache.misses() == 1);
+
+    // Same profile for another flight of the airline, the callsign number and the type (without RULES) don't count
+    CHECK(&cache.profile(table, request("AFR9", "A320")) == &afr);
+    CHECK(cache.hits() == 1);
+
+    const stand::CandidateProfile& baw = cache.profile(table, request("BAW45"));
+    CHECK(!baw.hasAirline); // no stand lists BAW
+    CHECK(names(table, baw.attributes) == "A1 A2");
+    CHECK(cache.size() == 2);
+    CHECK(cache.misses() == 2);
+}
+
+TEST_CASE(cacheKeysTypeOnlyWithRules)
+{
+    using Cache = stand::CandidateCache;
+    CHECK(Cache::profileKey(request("AFR1", "A320"), false) == Cache::profileKey(request("AFR1", "B738"), false));
+    CHECK(!(Cache::profileKey(request("AFR1", "A320"), true) == Cache::profileKey(request("AFR1", "B738"), true)));
+    CHECK(!(Cache::profileKey(request("AFR1"), false) == Cache::profileKey(request("BAW1"), false)));
+
+    const stand::StandTable table = compile(R"({ "RULES": ["A1 REQUIRE type = A320"], "STAND": {
+        "A1": { "use": "A" }, "A2": { "use": "A" }
+    } })");
+    stand::CandidateCache cache;
+    CHECK(names(table, cache.profile(table, request("", "A320")).attributes) == "A1 A2");
+    CHECK(names(table, cache.profile(table, request("", "B738")).attributes) == "A2");
+    CHECK(cache.misses() == 2);
+}
+
+TEST_CASE(cacheFollowsTableEpoch)
+{
+    const stand::StandTable first = compile();
+    stand::CandidateCache cache;
+    cache.profile(first, request("AFR1"));
+    cache.profile(first, request("BAW1"));
+    REQUIRE(cache.size() == 2);
+
+    // A reloaded config is a new epoch, even with the same stands
+    const stand::StandTable second = compile();
+    REQUIRE(second.index.epoch != first.index.epoch);
+    cache.profile(second, request("AFR1"));
+    CHECK(cache.size() == 1);
+    CHECK(cache.misses() == 3);
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+    cache.profile(second, request("AFR1"));
+    CHECK(cache.misses() == 4);
+}
+
+TEST_CASE(cacheLiveCandidatesPreferAirline)
+{
+    const stand::StandTable table = compile();
+    const stand::StandId a1 = *table.find("A1");
+    stand::CandidateCache cache;
+    const stand::CandidateProfile& afr = cache.profile(table, request("AFR1"));
+
+    stand::StandBitset occupied(table.size()), blocked(table.size()), out;
+    CHECK(stand::liveCandidates(table.index, afr, occupied, blocked, out));
+    CHECK(names(table, out) == "A1");
+
+    // The airline's stand taken: any stand, without the narrowing
+    occupied.set(a1);
+    CHECK(!stand::liveCandidates(table.index, afr, occupied, blocked, out));
+    CHECK(names(table, out) == "A2");
+
+    stand::StandBitset released(table.size());
+    released.set(a1);
+    CHECK(stand::liveCandidates(table.index, afr, occupied, blocked, out, &released));
+    CHECK(names(table, out) == "A1");
+
+    // Without an airline preference both stands stay candidates
+    occupied.reset(a1);
+    CHECK(!stand::liveCandidates(table.index, cache.profile(table, request("BAW1")), occupied, blocked, out));
+    CHECK(names(table, out) == "A1 A2");
+}
+
+TEST_CASE(cacheRelaxationLadder)
+{
+    // For a schengen airliner: A1 matches, N1 once schengen is given up, G1 once use is too
+    const stand::StandTable table = compile(R"({ "RELAX": ["schengen", "use"], "STAND": {
+        "A1": { "use": "A", "priority": 1 },
+        "N1": { "use": "A", "schengen": false, "priority": 1 },
+        "G1": { "use": "P", "priority": 1 }
+    } })");
+    const stand::StandId a1 = *table.find("A1"), n1 = *table.find("N1"), g1 = *table.find("G1");
+    stand::StandRequest schengen = request();
+    schengen.schengen = true;
+    stand::CandidateCache cache;
+    const stand::CandidateProfile& profile = cache.profile(table, schengen);
+    REQUIRE(profile.relaxed.size() == 2);
+    CHECK(names(table, profile.relaxed[0]) == "A1 N1");
+    CHECK(names(table, profile.relaxed[1]) == "A1 N1 G1"); // rungs add up
+
+    stand::StandBitset occupied(table.size()), blocked(table.size()), out;
+    occupied.set(a1);
+    CHECK(stand::relaxedCandidates(table.index, profile, occupied, blocked, out) == 1);
+    CHECK(names(table, out) == "N1");
+    blocked.set(n1);
+    CHECK(stand::relaxedCandidates(table.index, profile, occupied, blocked, out) == 2);
+    CHECK(names(table, out) == "G1");
+    occupied.set(g1);
+    CHECK(stand::relaxedCandidates(table.index, profile, occupied, blocked, out) == 0);
+    CHECK(!out.any());
+}
+
+TEST_CASE(cacheSelectBestReportsRung)
+{
+    const stand::StandTable table = compile(R"({ "RELAX": ["schengen"], "STAND": {
+        "A1": { "use": "A" },
+        "N1": { "use": "A", "schengen": false }
+    } })");
+    stand::StandRequest schengen = request();
+    schengen.schengen = true;
+    stand::CandidateCache cache;
+    const stand::CandidateProfile& profile = cache.profile(table, schengen);
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+
+    size_t rung = 99;
+    CHECK(occupancy.selectBest(table.index, profile, 0, nullptr, &rung) == table.find("A1"));
+    CHECK(rung == 0); // strict match, the ladder isn't walked
+
+    occupancy.occupy(*table.find("A1"));
+    CHECK(occupancy.selectBest(table.index, profile, 0, nullptr, &rung) == table.find("N1"));
+    CHECK(rung == 1);
+
+    occupancy.occupy(*table.find("N1"));
+    CHECK(!occupancy.selectBest(table.index, profile, 0, nullptr, &rung));
+    CHECK(rung == 0);
+
+    // Without a ladder nothing is relaxed
+    const stand::StandTable strict = compile(R"({ "STAND": { "N1": { "use": "A", "schengen": false } } })");
+    stand::StandOccupancy free;
+    free.reset(strict);
+    CHECK(!free.selectBest(strict.index, cache.profile(strict, schengen), 0, nullptr, &rung));
+}
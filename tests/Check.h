@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Minimal self-registering test runner, so the stand core tests build with the
+// COMPILER_ONLY toolchain alone (no test framework dependency).
+namespace test {
+    struct Case {
+        const char* name;
+        void (*run)();
+    };
+
+    std::vector<Case>& cases();
+    void fail(const char* file, int line, const std::string& expression);
+
+    struct Registrar {
+        Registrar(const char* name, void (*run)()) { cases().push_back({ name, run }); }
+    };
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static const test::Registrar name##Registrar(#name, name); \
+    static void name()
+
+// Records the failure and carries on with the rest of the case
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) test::fail(__FILE__, __LINE__, #expression); \
+    } while (0)
+
+// Stops the case, for checks later ones depend on
+#define REQUIRE(expression) \
+    do { \
+        if (!(expression)) { \
+            test::fail(__FILE__, __LINE__, #expression); \
+            return; \
+        } \
+    } while (0)
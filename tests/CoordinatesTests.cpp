@@ -0,0 +1,87 @@
+#include "Check.h"
+#include "core/Coordinates.h"
+
+namespace {
+    using stand::Axis;
+
+    bool rejected(std::string_view value, Axis axis)
+    {
+        return !stand::parseCoordinate(value, axis);
+    }
+}
+
+TEST_CASE(coordinatesDms)
+{
+    // 43 + 37/60 + 59.110/3600 degrees, in 1e-7 degree units
+    CHECK(stand::parseCoordinate("N043.37.59.110", Axis::latitude) == 436330861);
+    CHECK(stand::parseCoordinate("E001.22.09.990", Axis::longitude) == 13694417);
+    CHECK(stand::parseCoordinate("S043.37.59.110", Axis::latitude) == -436330861);
+    CHECK(stand::parseCoordinate("w001.22.09.990", Axis::longitude) == -13694417);
+
+    // Fractions shorter than milliseconds are scaled, longer ones cut
+    CHECK(stand::parseCoordinate("N000.00.01.5", Axis::latitude) == stand::parseCoordinate("N000.00.01.500", Axis::latitude));
+    CHECK(stand::parseCoordinate("N000.00.01.5009", Axis::latitude) == stand::parseCoordinate("N000.00.01.500", Axis::latitude));
+    CHECK(stand::parseCoordinate("N000.00.01", Axis::latitude) == 2778);
+}
+
+TEST_CASE(coordinatesDecimal)
+{
+    CHECK(stand::parseCoordinate("49.014006", Axis::latitude) == 490140060);
+    CHECK(stand::parseCoordinate("-2.538408", Axis::longitude) == -25384080);
+    CHECK(stand::parseCoordinate("+2.5", Axis::longitude) == 25000000);
+    CHECK(stand::parseCoordinate("180", Axis::longitude) == 1800000000);
+    CHECK(stand::parseCoordinate("-90.0", Axis::latitude) == -900000000);
+}
+
+TEST_CASE(coordinatesHemisphereFollowsAxis)
+{
+    CHECK(rejected("E043.37.59.110", Axis::latitude));
+    CHECK(rejected("W043.37.59.110", Axis::latitude));
+    CHECK(rejected("N001.22.09.990", Axis::longitude));
+    CHECK(rejected("s001.22.09.990", Axis::longitude));
+}
+
+TEST_CASE(coordinatesRange)
+{
+    CHECK(!rejected("N090.00.00", Axis::latitude));
+    CHECK(rejected("N090.00.01", Axis::latitude));
+    CHECK(rejected("N091.00.00", Axis::latitude));
+    CHECK(rejected("90.0000001", Axis::latitude));
+    CHECK(!rejected("E180.00.00", Axis::longitude));
+    CHECK(rejected("E180.00.00.001", Axis::longitude));
+    CHECK(rejected("E181.00.00", Axis::longitude));
+    CHECK(rejected("180.1", Axis::longitude));
+
+    // Degrees are bounded before any arithmetic, long runs of digits can't overflow
+    CHECK(rejected("N0043.00.00", Axis::latitude));
+    CHECK(rejected("E99999999999999999999.00.00", Axis::longitude));
+    CHECK(rejected("0045.5", Axis::latitude));
+    CHECK(rejected("N043.60.00", Axis::latitude));
+    CHECK(rejected("N043.00.60", Axis::latitude));
+}
+
+TEST_CASE(coordinatesMalformed)
+{
+    for (const char* value : { "", "N", "N043", "N043.37", "N043..59", "N043.37.59.", "N043.37.59x", "X043.37.59", "4x.5", "--4", "." }) {
+        CHECK(rejected(value, Axis::latitude));
+    }
+}
+
+TEST_CASE(coordinatesStandPosition)
+{
+    const auto position = stand::parseStandPosition("N043.37.59.110:E001.22.09.990:25");
+    REQUIRE(position);
+    CHECK(position->latitude == 436330861);
+    CHECK(position->longitude == 13694417);
+    CHECK(position->radius == 25);
+
+    const auto noRadius = stand::parseStandPosition("49.014006:2.538408");
+    REQUIRE(noRadius);
+    CHECK(noRadius->radius == 0);
+
+    CHECK(!stand::parseStandPosition("E001.22.09.990:N043.37.59.110:25")); // swapped axes
+    CHECK(!stand::parseStandPosition("N043.37.59.110"));
+    CHECK(!stand::parseStandPosition("N043.37.59.110:E001.22.09.990:"));
+    CHECK(!stand::parseStandPosition("N043.37.59.110:E001.22.09.990:65536"));
+    CHECK(!stand::parseStandPosition("N043.37.59.110:E001.22.09.990:25:1"));
+}
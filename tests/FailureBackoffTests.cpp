@@ -0,0 +1,90 @@
+#include <chrono>
+#include <vector>
+
+#include "Check.h"
+#include "core/FailureBackoff.h"
+
+namespace {
+    using Clock = stand::FailureBackoff::Clock;
+    using std::chrono::seconds;
+
+    const Clock::time_point T0{};
+}
+
+TEST_CASE(backoffUnknownKeyIsRetried)
+{
+    stand::FailureBackoff backoff;
+    CHECK(backoff.shouldRetry(1, T0));
+    CHECK(backoff.shouldRetry(1, T0, 42));
+    CHECK(backoff.failures(1) == 0);
+    CHECK(!backoff.contains(1));
+}
+
+TEST_CASE(backoffWaitsForTheDelay)
+{
+    stand::FailureBackoff backoff;
+    backoff.record(7, T0, seconds(10));
+    CHECK(!backoff.shouldRetry(7, T0));
+    CHECK(!backoff.shouldRetry(7, T0 + seconds(9)));
+    CHECK(backoff.shouldRetry(7, T0 + seconds(10)));
+    CHECK(backoff.shouldRetry(8, T0)); // other keys are not held back
+}
+
+TEST_CASE(backoffWaitsForTheEpoch)
+{
+    // A pilot that found no stand: retried once a stand was released, whatever the time
+    stand::FailureBackoff backoff;
+    backoff.record(7, T0, seconds(0), 3);
+    CHECK(!backoff.shouldRetry(7, T0, 3));
+    CHECK(!backoff.shouldRetry(7, T0 + seconds(3600), 3));
+    CHECK(backoff.shouldRetry(7, T0, 4));
+
+    // Both conditions when given both
+    backoff.record(7, T0, seconds(5), 4);
+    CHECK(!backoff.shouldRetry(7, T0 + seconds(1), 5));
+    CHECK(!backoff.shouldRetry(7, T0 + seconds(6), 4));
+    CHECK(backoff.shouldRetry(7, T0 + seconds(6), 5));
+}
+
+TEST_CASE(backoffLogsOnPowersOfTwo)
+{
+    stand::FailureBackoff backoff;
+    std::vector<uint32_t> logged;
+    for (uint32_t attempt = 1; attempt <= 20; ++attempt) {
+        if (backoff.record(7, T0, seconds(0))) logged.push_back(attempt);
+    }
+    CHECK(logged == std::vector<uint32_t>({ 1, 2, 4, 8, 16 }));
+    CHECK(backoff.failures(7) == 20);
+}
+
+TEST_CASE(backoffDelayDoublesUpToTheCap)
+{
+    // Missing airport config: 5 s, 10 s, 20 s... capped at 5 min
+    stand::FailureBackoff backoff;
+    std::vector<int64_t> delays;
+    for (int i = 0; i < 8; ++i) {
+        const seconds delay = backoff.nextDelay(1, seconds(5), seconds(300));
+        delays.push_back(delay.count());
+        backoff.record(1, T0, delay);
+    }
+    CHECK(delays == std::vector<int64_t>({ 5, 10, 20, 40, 80, 160, 300, 300 }));
+
+    // Long past the shift range, still capped
+    for (int i = 0; i < 100; ++i) backoff.record(1, T0, seconds(0));
+    CHECK(backoff.nextDelay(1, seconds(5), seconds(300)) == seconds(300));
+}
+
+TEST_CASE(backoffEraseResets)
+{
+    // A config file change: the airport is tried right away, and from the first delay again
+    stand::FailureBackoff backoff;
+    backoff.record(1, T0, seconds(300));
+    backoff.record(2, T0, seconds(300));
+    backoff.erase(1);
+    CHECK(backoff.shouldRetry(1, T0));
+    CHECK(backoff.nextDelay(1, seconds(5), seconds(300)) == seconds(5));
+    CHECK(!backoff.shouldRetry(2, T0));
+
+    backoff.clear();
+    CHECK(backoff.shouldRetry(2, T0));
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "utils/SlotMap.h"
+
+namespace {
+    using Map = stand::SlotMap<std::string>;
+
+    std::vector<std::string> sorted(const Map& map)
+    {
+        std::vector<std::string> values(map.begin(), map.end());
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+}
+
+TEST_CASE(slotMapNullHandle)
+{
+    Map map;
+    const Map::Handle none;
+    CHECK(!none);
+    CHECK(!map.contains(none));
+    CHECK(map.get(none) == nullptr);
+    CHECK(!map.erase(none));
+
+    map.insert("AFR123");
+    CHECK(!map.contains(none)); // slot 0 exists now, generation 0 still never matches
+}
+
+TEST_CASE(slotMapEraseKeepsOtherHandles)
+{
+    Map map;
+    const Map::Handle a = map.insert("AFR123");
+    const Map::Handle b = map.insert("BAW45");
+    const Map::Handle c = map.insert("DLH9");
+    CHECK(map.size() == 3);
+
+    // Erasing from the middle moves the last value into the hole
+    CHECK(map.erase(a));
+    CHECK(map.size() == 2);
+    CHECK(!map.contains(a));
+    CHECK(map.get(a) == nullptr);
+    REQUIRE(map.get(b) && map.get(c));
+    CHECK(*map.get(b) == "BAW45");
+    CHECK(*map.get(c) == "DLH9");
+    CHECK(sorted(map) == std::vector<std::string>({ "BAW45", "DLH9" }));
+
+    CHECK(!map.erase(a)); // already gone
+    CHECK(map.erase(c));  // last value, nothing to move
+    CHECK(map.erase(b));
+    CHECK(map.empty());
+}
+
+TEST_CASE(slotMapReusedSlotRejectsOldHandle)
+{
+    Map map;
+    const Map::Handle old = map.insert("AFR123");
+    map.insert("BAW45");
+    CHECK(map.erase(old));
+
+    const Map::Handle reused = map.insert("EZY77");
+    CHECK(reused.slot == old.slot);
+    CHECK(reused.generation != old.generation);
+    CHECK(!(reused == old));
+    CHECK(!map.contains(old));
+    CHECK(map.get(old) == nullptr);
+    CHECK(!map.erase(old));
+    REQUIRE(map.get(reused));
+    CHECK(*map.get(reused) == "EZY77");
+    CHECK(map.size() == 2);
+}
+
+TEST_CASE(slotMapClear)
+{
+    Map map;
+    std::vector<Map::Handle> handles;
+    for (const char* callsign : { "AFR1", "AFR2", "AFR3" }) handles.push_back(map.insert(callsign));
+
+    map.clear();
+    CHECK(map.empty());
+    for (const Map::Handle& handle : handles) CHECK(!map.contains(handle));
+
+    // Slots are reused, none of the old handles reaches the new values
+    for (const char* callsign : { "BAW1", "BAW2", "BAW3", "BAW4" }) map.insert(callsign);
+    CHECK(map.size() == 4);
+    for (const Map::Handle& handle : handles) CHECK(map.get(handle) == nullptr);
+}
+
+TEST_CASE(slotMapChurn)
+{
+    // Interleaved inserts and erases against a plain list of live handles
+    Map map;
+    std::vector<std::pair<Map::Handle, std::string>> live;
+    std::vector<Map::Handle> dead;
+    for (int i = 0; i < 200; ++i) {
+        const std::string number = std::to_string(i);
+        const std::string value = "P" + number;
+        live.emplace_back(map.insert(value), value);
+        if (i % 3 == 2) {
+            const size_t victim = static_cast<size_t>(i * 7) % live.size();
+            CHECK(map.erase(live[victim].first));
+            dead.push_back(live[victim].first);
+            live.erase(live.begin() + static_cast<std::ptrdiff_t>(victim));
+        }
+    }
+
+    CHECK(map.size() == live.size());
+    for (const auto& [handle, value] : live) {
+        const std::string* stored = map.get(handle);
+        CHECK(stored && *stored == value);
+    }
+    for (const Map::Handle& handle : dead) CHECK(!map.contains(handle));
+}
+
+TEST_CASE(slotMapMoveOnlyValues)
+{
+    stand::SlotMap<std::unique_ptr<int>> map;
+    const auto a = map.insert(std::make_unique<int>(1));
+    const auto b = map.insert(std::make_unique<int>(2));
+    CHECK(map.erase(a));
+    REQUIRE(map.get(b) && *map.get(b));
+    CHECK(**map.get(b) == 2);
+}
@@ -0,0 +1,119 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Check.h"
+#include "core/StandBundle.h"
+
+namespace {
+    stand::StandTable airport(const std::string& icao, const char* version, std::initializer_list<const char*> names)
+    {
+        nlohmann::ordered_json config;
+        config["version"] = version;
+        for (const char* name : names) config["STAND"][name] = { { "use", "A" }, { "code", "C" } };
+        stand::StandTable table;
+        std::string error;
+        stand::compileStandTable(config, icao, table, error);
+        return table;
+    }
+
+    std::filesystem::path bundlePath()
+    {
+        return std::filesystem::temp_directory_path() / "neostand-tests.nsbundle";
+    }
+
+    // Overwrites size bytes of the file at offset
+    void patch(const std::filesystem::path& path, std::streamoff offset, const void* bytes, size_t size)
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(offset);
+        file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+    }
+}
+
+TEST_CASE(bundleRoundTrip)
+{
+    const std::vector<stand::StandTable> tables = {
+        airport("LFBO", "1.0.0", { "A1", "A2", "B1" }),
+        airport("LFPG", "1.0.0", { "E10", "E12" }),
+    };
+    std::string error;
+    const std::filesystem::path path = bundlePath();
+    REQUIRE(stand::writeStandBundle(tables, path, error));
+    CHECK(!std::filesystem::exists(path.string() + ".tmp"));
+
+    stand::StandBundle bundle;
+    REQUIRE(bundle.open(path, error));
+    CHECK(bundle.version() == "1.0.0");
+    CHECK(bundle.size() == 2);
+    CHECK(bundle.contains("LFBO"));
+    CHECK(!bundle.contains("LFPO"));
+
+    // Sections are decoded on demand, each one on its own
+    stand::StandTable decoded;
+    REQUIRE(bundle.decode("LFPG", decoded, error));
+    CHECK(decoded.icao == "LFPG");
+    CHECK(decoded.names == tables[1].names);
+    CHECK(decoded.code == tables[1].code);
+    REQUIRE(bundle.decode("LFBO", decoded, error));
+    CHECK(decoded.names == tables[0].names);
+    CHECK(decoded.index.all.count() == 3);
+
+    CHECK(!bundle.decode("LFPO", decoded, error));
+    CHECK(error.find("LFPO not found") == 0);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE(bundleRejectsMixedVersions)
+{
+    const std::vector<stand::StandTable> tables = {
+        airport("LFBO", "1.0.0", { "A1" }),
+        airport("LFPG", "1.1.0", { "E10" }),
+    };
+    std::string error;
+    const std::filesystem::path path = bundlePath();
+    std::filesystem::remove(path);
+    CHECK(!stand::writeStandBundle(tables, path, error));
+    CHECK(error.find("LFPG") != std::string::npos);
+    CHECK(!std::filesystem::exists(path));
+}
+
+TEST_CASE(bundleRejectsDamagedFiles)
+{
+    const std::vector<stand::StandTable> tables = { airport("LFBO", "1.0.0", { "A1", "A2" }) };
+    std::string error;
+    const std::filesystem::path path = bundlePath();
+    stand::StandBundle bundle;
+    CHECK(!bundle.open(path.string() + ".missing", error));
+
+    // Another format version
+    REQUIRE(stand::writeStandBundle(tables, path, error));
+    const uint32_t version = stand::bundle::FORMAT_VERSION + 1;
+    patch(path, offsetof(stand::bundle::Header, formatVersion), &version, sizeof(version));
+    CHECK(!bundle.open(path, error));
+    CHECK(error.starts_with("Unsupported bundle format"));
+
+    // A section past the end of the file
+    REQUIRE(stand::writeStandBundle(tables, path, error));
+    stand::bundle::Header header{};
+    std::ifstream(path, std::ios::binary).read(reinterpret_cast<char*>(&header), sizeof(header));
+    const uint32_t size = 1 << 20;
+    patch(path, header.indexOffset + offsetof(stand::bundle::IndexEntry, compressedSize), &size, sizeof(size));
+    CHECK(!bundle.open(path, error));
+    CHECK(error.starts_with("Corrupted bundle index"));
+    CHECK(bundle.size() == 0);
+
+    // Compressed bytes that don't inflate, only found once the section is decoded
+    REQUIRE(stand::writeStandBundle(tables, path, error));
+    const char garbage[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    patch(path, sizeof(stand::bundle::Header) + sizeof(stand::bundle::IndexEntry), garbage, sizeof(garbage));
+    REQUIRE(bundle.open(path, error));
+    stand::StandTable decoded;
+    CHECK(!bundle.decode("LFBO", decoded, error));
+    CHECK(error == "Corrupted bundle section for LFBO");
+    std::filesystem::remove(path);
+}
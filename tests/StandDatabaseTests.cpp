@@ -0,0 +1,219 @@
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+
+#include <nlohmann/json.hpp>
+
+#include "Check.h"
+#include "core/StandDatabase.h"
+
+namespace {
+    // Every section of the format in use: blocks, airlines, positions, relaxations, rules, types and taxi distances
+    const char* CONFIG = R"({
+        "version": "1.0.0",
+        "RELAX": ["wtc", "schengen"],
+        "RULES": ["A* REQUIRE code >= C AND NOT airline = RYR"],
+        "TAXI": {
+            "NODES": {
+                "T1": "N043.37.59.000:E001.22.09.000:0",
+                "T2": "N043.37.55.000:E001.22.05.000:0"
+            },
+            "TAXIWAYS": [["T1", "T2"]],
+            "EXITS": { "14R": ["T1"] }
+        },
+        "STAND": {
+            "A1": { "coordinates": "N043.37.59.110:E001.22.09.990:25", "use": "A", "code": "E", "WTC": "H", "schengen": true, "priority": 2, "BLOCK": ["A2"], "callsign": ["afr", "KLM"] },
+            "A2": { "coordinates": "N043.37.58.273:E001.22.08.319:30", "use": "A", "code": "C", "national": false, "BLOCK": ["A1"] },
+            "G1": { "use": "P", "atyp": ["AT43", "AT45"] },
+            "H1": { "use": "H", "atyp": "AT72,AT76" }
+        }
+    })";
+
+    bool compile(const char* config, stand::StandTable& table, std::string& error)
+    {
+        return stand::compileStandTable(nlohmann::ordered_json::parse(config), "LFBO", table, error);
+    }
+
+    bool decode(const std::vector<char>& image, stand::StandTable& table, std::string& error)
+    {
+        stand::StandDatabase database;
+        return database.open(std::vector<uint8_t>(image.begin(), image.end()), "test image", error) && database.toStandTable(table, error);
+    }
+
+    void checkSameTable(const stand::StandTable& a, const stand::StandTable& b)
+    {
+        CHECK(a.icao == b.icao);
+        CHECK(a.version == b.version);
+        CHECK(a.names == b.names);
+        CHECK(a.use == b.use);
+        CHECK(a.code == b.code);
+        CHECK(a.wtc == b.wtc);
+        CHECK(a.flags == b.flags);
+        CHECK(a.priority == b.priority);
+        CHECK(a.latitude == b.latitude);
+        CHECK(a.longitude == b.longitude);
+        CHECK(a.radius == b.radius);
+        CHECK(a.blockOffsets == b.blockOffsets);
+        CHECK(a.blocks == b.blocks);
+        CHECK(a.airlineOffsets == b.airlineOffsets);
+        CHECK(a.airlines == b.airlines);
+        CHECK(a.typeOffsets == b.typeOffsets);
+        CHECK(a.types == b.types);
+        CHECK(a.relaxations == b.relaxations);
+        CHECK(a.ruleSources == b.ruleSources);
+        CHECK(a.rules.dump() == b.rules.dump());
+        CHECK(a.taxi.runways() == b.taxi.runways());
+        CHECK(a.taxi.matrix() == b.taxi.matrix());
+        CHECK(a.index.priorityLevel == b.index.priorityLevel);
+    }
+}
+
+TEST_CASE(databaseRoundTrip)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(compile(CONFIG, table, error));
+    REQUIRE(table.size() == 4);
+    CHECK(table.warnings.empty());
+    CHECK(!table.taxi.empty());
+
+    stand::StandTable decoded;
+    REQUIRE(decode(stand::serializeStandDatabase(table), decoded, error));
+    checkSameTable(table, decoded);
+
+    // Encoding the decoded table gives the same image again
+    CHECK(stand::serializeStandDatabase(decoded) == stand::serializeStandDatabase(table));
+}
+
+TEST_CASE(databaseRoundTripThroughFile)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(compile(CONFIG, table, error));
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "neostand-tests-LFBO.nsdb";
+    REQUIRE(stand::writeStandDatabase(table, path, error));
+    CHECK(!std::filesystem::exists(path.string() + ".tmp"));
+
+    stand::StandDatabase database;
+    stand::StandTable decoded;
+    const bool opened = database.open(path, error) && database.toStandTable(decoded, error);
+    database.close();
+    std::filesystem::remove(path);
+    REQUIRE(opened);
+
+    // The columns view the mapping, which outlives the database and the file name
+    CHECK(decoded.use.isView());
+    CHECK(decoded.blocks.isView());
+    CHECK(decoded.taxi.matrix().isView());
+    checkSameTable(table, decoded);
+}
+
+TEST_CASE(databaseViewsCopyOnWrite)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(compile(CONFIG, table, error));
+    stand::StandTable decoded;
+    REQUIRE(decode(stand::serializeStandDatabase(table), decoded, error));
+
+    // A copy shares the view, writing detaches only the written column
+    stand::StandTable copy = decoded;
+    REQUIRE(copy.priority.isView());
+    copy.priority[0] = 9;
+    CHECK(!copy.priority.isView());
+    CHECK(copy.priority[0] == 9);
+    CHECK(decoded.priority[0] == table.priority[0]);
+    CHECK(copy.priority[1] == decoded.priority[1]);
+    CHECK(copy.code.isView());
+}
+
+TEST_CASE(databaseWithoutStands)
+{
+    stand::StandTable table;
+    table.icao = "ZZZZ";
+    std::string error;
+    REQUIRE(table.finalize(error));
+
+    stand::StandTable decoded;
+    REQUIRE(decode(stand::serializeStandDatabase(table), decoded, error));
+    CHECK(decoded.icao == "ZZZZ");
+    CHECK(decoded.size() == 0);
+    CHECK(decoded.rules.empty());
+    CHECK(decoded.taxi.empty());
+}
+
+TEST_CASE(databaseLongIdentifiersAreCut)
+{
+    // icao and version are fixed size header fields
+    stand::StandTable table;
+    table.icao = "ABCDEFGHIJ";
+    table.version = "0123456789abcdefXYZ";
+    table.addStand("S1");
+    std::string error;
+    REQUIRE(table.finalize(error));
+
+    stand::StandTable decoded;
+    REQUIRE(decode(stand::serializeStandDatabase(table), decoded, error));
+    CHECK(decoded.icao == "ABCDEFGH");
+    CHECK(decoded.version == "0123456789abcdef");
+}
+
+TEST_CASE(databaseRejectsDamagedImages)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(compile(CONFIG, table, error));
+    const std::vector<char> image = stand::serializeStandDatabase(table);
+    stand::StandTable decoded;
+
+    std::vector<char> truncated(image.begin(), image.begin() + sizeof(stand::db::Header) - 1);
+    CHECK(!decode(truncated, decoded, error));
+
+    std::vector<char> cut(image.begin(), image.end() - 1); // string table runs past the end
+    CHECK(!decode(cut, decoded, error));
+
+    std::vector<char> magic = image;
+    magic[0] = 'X';
+    CHECK(!decode(magic, decoded, error));
+
+    std::vector<char> version = image;
+    const uint32_t otherVersion = stand::db::FORMAT_VERSION + 1;
+    std::memcpy(version.data() + offsetof(stand::db::Header, formatVersion), &otherVersion, sizeof(otherVersion));
+    CHECK(!decode(version, decoded, error));
+
+    // Section past the end of the image
+    stand::db::Header header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    std::vector<char> section = image;
+    const uint32_t farAway = static_cast<uint32_t>(image.size() + 8);
+    std::memcpy(section.data() + offsetof(stand::db::Header, sections) + sizeof(stand::db::SectionRef) * size_t(stand::db::Section::types), &farAway, sizeof(farAway));
+    CHECK(!decode(section, decoded, error));
+
+    // Block pointing past the last stand
+    REQUIRE(header.section(stand::db::Section::blocks).count > 0);
+    std::vector<char> block = image;
+    const stand::StandId outOfRange = static_cast<stand::StandId>(header.standCount);
+    std::memcpy(block.data() + header.section(stand::db::Section::blocks).offset, &outOfRange, sizeof(outOfRange));
+    CHECK(!decode(block, decoded, error));
+
+    // CSR offsets never go back
+    REQUIRE(header.section(stand::db::Section::types).count >= 4);
+    std::vector<char> types = image;
+    const uint32_t backwards = UINT32_MAX;
+    std::memcpy(types.data() + header.section(stand::db::Section::typeOffsets).offset + sizeof(uint32_t), &backwards, sizeof(backwards));
+    CHECK(!decode(types, decoded, error));
+
+    // Attribute code outside its enum
+    std::vector<char> use = image;
+    use[header.section(stand::db::Section::use).offset] = 99;
+    CHECK(!decode(use, decoded, error));
+
+    // Unknown relaxation rung
+    std::vector<char> relax = image;
+    relax[offsetof(stand::db::Header, relaxations)] = 99;
+    CHECK(!decode(relax, decoded, error));
+
+    // The untouched image still decodes
+    CHECK(decode(image, decoded, error));
+}
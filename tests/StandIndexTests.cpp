@@ -0,0 +1,134 @@
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "Check.h"
+#include "core/StandTable.h"
+
+namespace {
+    const char* CONFIG = R"({ "STAND": {
+        "A1": { "use": "A", "code": "E", "WTC": "H", "schengen": true },
+        "A2": { "use": "A", "code": "C", "national": false },
+        "G1": { "use": "P" },
+        "X1": {}
+    } })";
+
+    stand::StandTable compile()
+    {
+        stand::StandTable table;
+        std::string error;
+        stand::compileStandTable(nlohmann::ordered_json::parse(CONFIG), "TEST", table, error);
+        return table;
+    }
+
+    std::string names(const stand::StandTable& table, const stand::StandBitset& stands)
+    {
+        std::string result;
+        stands.forEach([&](size_t id) { result += (result.empty() ? "" : " ") + table.names[id]; });
+        return result;
+    }
+
+    stand::StandBitset bits(const stand::StandTable& table, std::initializer_list<const char*> set)
+    {
+        stand::StandBitset result(table.size());
+        for (const char* name : set) result.set(*table.find(name));
+        return result;
+    }
+
+    stand::StandRequest airliner(stand::StandCode code, stand::StandWtc wtc, bool schengen, bool national)
+    {
+        stand::StandRequest request;
+        request.use = stand::StandUse::airliner;
+        request.code = code;
+        request.wtc = wtc;
+        request.schengen = schengen;
+        request.national = national;
+        return request;
+    }
+}
+
+TEST_CASE(indexBitmaps)
+{
+    const stand::StandTable table = compile();
+    const stand::StandIndex& index = table.index;
+    REQUIRE(table.size() == 4);
+
+    // Stands without the restriction are in every bitmap of the attribute
+    CHECK(names(table, index.byUse[static_cast<size_t>(stand::StandUse::airliner)]) == "A1 A2 X1");
+    CHECK(names(table, index.byUse[static_cast<size_t>(stand::StandUse::generalAviation)]) == "G1 X1");
+    CHECK(names(table, index.byWtc[static_cast<size_t>(stand::StandWtc::H)]) == "A1 A2 G1 X1");
+    CHECK(names(table, index.byWtc[static_cast<size_t>(stand::StandWtc::M)]) == "A2 G1 X1");
+    CHECK(names(table, index.bySchengen[true]) == "A1 A2 G1 X1");
+    CHECK(names(table, index.bySchengen[false]) == "A2 G1 X1");
+    CHECK(names(table, index.byNational[true]) == "A1 G1 X1");
+
+    // Larger stands take smaller aircraft
+    CHECK(names(table, index.byCode[static_cast<size_t>(stand::StandCode::C)]) == "A1 A2 G1 X1");
+    CHECK(names(table, index.byCode[static_cast<size_t>(stand::StandCode::D)]) == "A1 G1 X1");
+    CHECK(names(table, index.byCode[static_cast<size_t>(stand::StandCode::F)]) == "G1 X1");
+    CHECK(index.all.count() == 4);
+}
+
+TEST_CASE(indexAttributes)
+{
+    const stand::StandTable table = compile();
+    stand::StandBitset out;
+    table.index.attributes(airliner(stand::StandCode::C, stand::StandWtc::M, true, false), out);
+    CHECK(names(table, out) == "A2 X1");
+    table.index.attributes(airliner(stand::StandCode::E, stand::StandWtc::H, true, true), out);
+    CHECK(names(table, out) == "A1 X1");
+    // Unknown use and WTC only fit stands without that restriction, unknown size fits every code
+    table.index.attributes(stand::StandRequest{}, out);
+    CHECK(names(table, out) == "X1");
+}
+
+TEST_CASE(indexCandidates)
+{
+    const stand::StandTable table = compile();
+    const stand::StandRequest request = airliner(stand::StandCode::C, stand::StandWtc::H, true, false);
+    const stand::StandBitset none(table.size());
+    stand::StandBitset out;
+
+    table.index.candidates(request, none, none, out);
+    CHECK(names(table, out) == "A1 A2 X1");
+    table.index.candidates(request, bits(table, { "A1" }), bits(table, { "X1" }), out);
+    CHECK(names(table, out) == "A2");
+
+    // Released stands count as free, as long as the request accepts them
+    const stand::StandBitset released = bits(table, { "X1", "G1" });
+    table.index.candidates(request, bits(table, { "A1" }), bits(table, { "X1", "G1" }), out, &released);
+    CHECK(names(table, out) == "A2 X1");
+
+    // Same result from the precomputed attributes
+    stand::StandBitset attributes;
+    table.index.attributes(request, attributes);
+    stand::StandBitset fromAttributes;
+    table.index.candidates(attributes, bits(table, { "A1" }), bits(table, { "X1", "G1" }), fromAttributes, &released);
+    CHECK(names(table, fromAttributes) == names(table, out));
+}
+
+TEST_CASE(indexLargeAirport)
+{
+    // More than one word per bitmap, the last one only partly used
+    nlohmann::ordered_json config;
+    for (int i = 0; i < 150; ++i) {
+        const std::string number = std::to_string(i);
+        config["STAND"]["S" + number] = { { "use", i % 2 ? "A" : "C" } };
+    }
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(stand::compileStandTable(config, "TEST", table, error));
+    REQUIRE(table.index.all.wordCount() == 3);
+    CHECK(table.index.all.count() == 150);
+
+    stand::StandRequest cargo;
+    cargo.use = stand::StandUse::cargo;
+    stand::StandBitset occupied(table.size());
+    occupied.set(*table.find("S148"));
+    stand::StandBitset out;
+    table.index.candidates(cargo, occupied, stand::StandBitset(table.size()), out);
+    CHECK(out.count() == 74);
+    CHECK(!out.test(*table.find("S148")));
+    CHECK(out.test(*table.find("S146")));
+    CHECK(out.nth(73) == *table.find("S146"));
+}
@@ -0,0 +1,112 @@
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Check.h"
+#include "core/StandMatcher.h"
+
+namespace {
+    stand::StandTable compile(const char* config)
+    {
+        stand::StandTable table;
+        std::string error;
+        stand::compileStandTable(nlohmann::ordered_json::parse(config), "TEST", table, error);
+        return table;
+    }
+
+    stand::StandRequest request(stand::StandCode code, std::string_view airline = "")
+    {
+        stand::StandRequest result;
+        result.use = stand::StandUse::airliner;
+        result.code = code;
+        result.airline = airline.empty() ? 0 : stand::airlineKey(airline);
+        return result;
+    }
+
+    // Stand name per pilot, "-" when left without one
+    std::vector<std::string> names(const stand::StandTable& table, const std::vector<std::optional<stand::StandId>>& matched)
+    {
+        std::vector<std::string> result;
+        for (const auto& id : matched) result.push_back(id ? table.names[*id] : "-");
+        return result;
+    }
+
+    std::vector<std::string> match(const stand::StandTable& table, const stand::StandOccupancy& occupancy, const std::vector<stand::StandRequest>& requests,
+        const std::vector<stand::StandBitset>* released = nullptr)
+    {
+        return names(table, stand::matchStands(table, occupancy, requests, released));
+    }
+}
+
+TEST_CASE(matcherBeatsGreedyOrder)
+{
+    // Picking by priority level for the code C pilot first would take the only stand the code E pilot fits
+    const stand::StandTable table = compile(R"({ "STAND": {
+        "E1": { "use": "A", "code": "E", "priority": 1 },
+        "C1": { "use": "A", "code": "C", "priority": 2 }
+    } })");
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+
+    CHECK(match(table, occupancy, { request(stand::StandCode::C), request(stand::StandCode::E) }) == std::vector<std::string>({ "C1", "E1" }));
+    CHECK(match(table, occupancy, { request(stand::StandCode::E), request(stand::StandCode::C) }) == std::vector<std::string>({ "E1", "C1" }));
+    CHECK(match(table, occupancy, { request(stand::StandCode::C) }) == std::vector<std::string>({ "C1" })); // size waste outweighs priority
+}
+
+TEST_CASE(matcherMorePilotsThanStands)
+{
+    const stand::StandTable table = compile(R"({ "STAND": {
+        "A1": { "use": "A", "code": "C" },
+        "A2": { "use": "A", "code": "E" },
+        "G1": { "use": "P" }
+    } })");
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+
+    // The code E pilot needs A2, the code C ones share what is left
+    const std::vector<std::string> matched = match(table, occupancy,
+        { request(stand::StandCode::C), request(stand::StandCode::E), request(stand::StandCode::C) });
+    CHECK(matched[1] == "A2");
+    CHECK((matched[0] == "A1") != (matched[2] == "A1"));
+    CHECK((matched[0] == "-") != (matched[2] == "-"));
+
+    CHECK(match(table, occupancy, {}).empty());
+    occupancy.occupy(*table.find("A1"));
+    occupancy.occupy(*table.find("A2"));
+    CHECK(match(table, occupancy, { request(stand::StandCode::C), request(stand::StandCode::C) }) == std::vector<std::string>({ "-", "-" }));
+}
+
+TEST_CASE(matcherAirlinePreference)
+{
+    const stand::StandTable table = compile(R"({ "STAND": {
+        "A1": { "use": "A", "priority": 1 },
+        "A2": { "use": "A", "priority": 2, "callsign": ["AFR"] }
+    } })");
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+
+    CHECK(match(table, occupancy, { request(stand::StandCode::C, "AFR123") }) == std::vector<std::string>({ "A2" }));
+    CHECK(match(table, occupancy, { request(stand::StandCode::C, "BAW45"), request(stand::StandCode::C, "AFR123") })
+        == std::vector<std::string>({ "A1", "A2" }));
+    // Two AFR, only one preferred stand: the other still gets one
+    const std::vector<std::string> both = match(table, occupancy, { request(stand::StandCode::C, "AFR1"), request(stand::StandCode::C, "AFR2") });
+    CHECK(both[0] != "-" && both[1] != "-" && both[0] != both[1]);
+}
+
+TEST_CASE(matcherReleasedPerPilot)
+{
+    // A1 is held, but free before the second pilot's ETA only
+    const stand::StandTable table = compile(R"({ "STAND": {
+        "A1": { "use": "A", "priority": 1 },
+        "A2": { "use": "A", "priority": 2 }
+    } })");
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+    occupancy.occupy(*table.find("A1"));
+
+    std::vector<stand::StandBitset> released(2, stand::StandBitset(table.size()));
+    released[1].set(*table.find("A1"));
+    CHECK(match(table, occupancy, { request(stand::StandCode::C), request(stand::StandCode::C) }, &released)
+        == std::vector<std::string>({ "A2", "A1" }));
+}
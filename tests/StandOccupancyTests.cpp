@@ -0,0 +1,167 @@
+#include <set>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include "Check.h"
+#include "core/StandOccupancy.h"
+
+namespace {
+    // Priority levels: P1 (A1 A2), P2 (B1), none (C1)
+    const char* CONFIG = R"({ "STAND": {
+        "A1": { "priority": 1 },
+        "A2": { "priority": 1 },
+        "B1": { "priority": 2 },
+        "C1": {}
+    } })";
+
+    stand::StandTable compile(const char* config = CONFIG)
+    {
+        stand::StandTable table;
+        std::string error;
+        stand::compileStandTable(nlohmann::ordered_json::parse(config), "TEST", table, error);
+        return table;
+    }
+
+    std::string pick(const stand::StandTable& table, const stand::StandOccupancy& occupancy, uint32_t random,
+        const stand::StandBitset* released = nullptr)
+    {
+        std::optional<stand::StandId> best = occupancy.selectBest(table.index, stand::StandRequest{}, random, released);
+        return best ? table.names[*best] : "none";
+    }
+}
+
+TEST_CASE(occupancyFreeCountsPerPriority)
+{
+    const stand::StandTable table = compile();
+    REQUIRE(table.index.priorityValues == std::vector<uint8_t>({ 1, 2, 0 }));
+
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+    CHECK(occupancy.freeCount(0) == 2);
+    CHECK(occupancy.freeCount(1) == 1);
+    CHECK(occupancy.freeCount(2) == 1);
+    CHECK(occupancy.freeCount(3) == 0); // no such level
+
+    occupancy.occupy(*table.find("A1"));
+    occupancy.block(*table.find("C1"));
+    CHECK(occupancy.freeCount(0) == 1);
+    CHECK(occupancy.freeCount(2) == 0);
+
+    // Occupied and blocked at once, free again only once both are gone
+    occupancy.block(*table.find("A1"));
+    occupancy.release(*table.find("A1"));
+    CHECK(occupancy.freeCount(0) == 1);
+    occupancy.unblock(*table.find("A1"));
+    CHECK(occupancy.freeCount(0) == 2);
+
+    // Dropping what isn't held changes nothing
+    occupancy.release(*table.find("B1"));
+    occupancy.unblock(*table.find("B1"));
+    CHECK(occupancy.freeCount(1) == 1);
+
+    occupancy.reset(table);
+    CHECK(occupancy.freeCount(2) == 1);
+    CHECK(!occupancy.blocked().any());
+}
+
+TEST_CASE(occupancyPicksBestPriority)
+{
+    const stand::StandTable table = compile();
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+
+    // Random among the best level only
+    std::set<std::string> picked;
+    for (uint32_t random = 0; random < 8; ++random) picked.insert(pick(table, occupancy, random));
+    CHECK(picked == std::set<std::string>({ "A1", "A2" }));
+
+    occupancy.occupy(*table.find("A1"));
+    CHECK(pick(table, occupancy, 0) == "A2");
+    CHECK(pick(table, occupancy, 1) == "A2");
+    occupancy.occupy(*table.find("A2"));
+    CHECK(pick(table, occupancy, 0) == "B1");
+    occupancy.occupy(*table.find("B1"));
+    CHECK(pick(table, occupancy, 0) == "C1"); // stands without PRIORITY come last
+    occupancy.occupy(*table.find("C1"));
+    CHECK(pick(table, occupancy, 0) == "none");
+}
+
+TEST_CASE(occupancyFullLevelWithReleasedStand)
+{
+    // P1 has no free stand left, but A2 is released before the pilot needs it
+    const stand::StandTable table = compile(R"({ "STAND": {
+        "A1": { "priority": 1 }, "A2": { "priority": 1 }, "B1": { "priority": 2 }
+    } })");
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+    occupancy.occupy(*table.find("A1"));
+    occupancy.occupy(*table.find("A2"));
+    REQUIRE(occupancy.freeCount(0) == 0);
+    CHECK(pick(table, occupancy, 0) == "B1");
+
+    stand::StandBitset released(table.size());
+    released.set(*table.find("A2"));
+    CHECK(pick(table, occupancy, 0, &released) == "A2");
+    CHECK(pick(table, occupancy, 1, &released) == "A2");
+
+    const stand::StandBitset none(table.size());
+    CHECK(pick(table, occupancy, 0, &none) == "B1");
+}
+
+TEST_CASE(occupancyHoldsOverlappingBlocks)
+{
+    // A1 and A2 both block B1, A1 also blocks A2
+    const stand::StandTable table = compile(R"({ "STAND": {
+        "A1": { "BLOCK": ["A2", "B1"] }, "A2": { "BLOCK": ["B1"] }, "B1": {}
+    } })");
+    const stand::StandId a1 = *table.find("A1"), a2 = *table.find("A2"), b1 = *table.find("B1");
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+    CHECK(occupancy.blocks(a1).size() == 2);
+
+    occupancy.hold(a1);
+    occupancy.hold(a2);
+    CHECK(occupancy.occupied().test(a1) && occupancy.occupied().test(a2));
+    CHECK(occupancy.blockCount(a2) == 1);
+    CHECK(occupancy.blockCount(b1) == 2);
+
+    // Dropping one hold keeps what the other still holds
+    const uint64_t epoch = occupancy.releaseEpoch();
+    occupancy.unhold(a1);
+    CHECK(occupancy.releaseEpoch() > epoch);
+    CHECK(!occupancy.occupied().test(a1));
+    CHECK(occupancy.occupied().test(a2));
+    CHECK(!occupancy.blocked().test(a2));
+    CHECK(occupancy.blocked().test(b1));
+    CHECK(occupancy.blockCount(b1) == 1);
+
+    occupancy.unhold(a2);
+    CHECK(!occupancy.occupied().any());
+    CHECK(!occupancy.blocked().any());
+    CHECK(occupancy.freeCount(0) == 3);
+}
+
+TEST_CASE(occupancyCountsRepeatedOccupy)
+{
+    const stand::StandTable table = compile();
+    const stand::StandId a1 = *table.find("A1");
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+
+    occupancy.occupy(a1);
+    occupancy.occupy(a1);
+    occupancy.release(a1);
+    CHECK(occupancy.occupied().test(a1));
+    CHECK(occupancy.freeCount(0) == 1);
+    occupancy.release(a1);
+    CHECK(!occupancy.occupied().test(a1));
+    CHECK(occupancy.freeCount(0) == 2);
+
+    // Releasing a free stand changes nothing, not even the epoch
+    const uint64_t epoch = occupancy.releaseEpoch();
+    occupancy.release(a1);
+    occupancy.unblock(a1);
+    CHECK(occupancy.releaseEpoch() == epoch);
+    CHECK(occupancy.freeCount(0) == 2);
+}
@@ -0,0 +1,196 @@
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "core/AircraftDatabase.h"
+#include "core/StandTable.h"
+
+namespace {
+    // A1 A2 B1 K.12 (a name the rule lexer can't read)
+    bool build(const std::vector<std::string>& rules, stand::StandTable& table, std::string& error)
+    {
+        table = stand::StandTable{};
+        table.icao = "TEST";
+        for (const char* name : { "A1", "A2", "B1", "K.12" }) table.addStand(name);
+        table.ruleSources = rules;
+        return table.finalize(error);
+    }
+
+    bool compiles(const std::string& rule)
+    {
+        stand::StandTable table;
+        std::string error;
+        return build({ rule }, table, error);
+    }
+
+    // Stands left to the request once the rules are applied, as a string of names
+    std::string allowed(const stand::StandTable& table, const stand::StandRequest& request)
+    {
+        stand::StandBitset stands(table.size());
+        for (size_t id = 0; id < table.size(); ++id) stands.set(id);
+        table.rules.apply(request, stands);
+        std::string names;
+        stands.forEach([&](size_t id) { names += (names.empty() ? "" : " ") + table.names[id]; });
+        return names;
+    }
+
+    stand::StandRequest request(stand::StandCode code, std::string_view airline = "", stand::StandUse use = stand::StandUse::airliner)
+    {
+        stand::StandRequest result;
+        result.code = code;
+        result.use = use;
+        result.airline = airline.empty() ? 0 : stand::airlineKey(airline);
+        return result;
+    }
+}
+
+TEST_CASE(rulesWithoutRules)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(build({}, table, error));
+    CHECK(table.rules.empty());
+    CHECK(allowed(table, {}) == "A1 A2 B1 K.12");
+}
+
+TEST_CASE(rulesPrefixAndList)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(build({ "A* REQUIRE wtc = H,J", "A1 , B1 REQUIRE schengen" }, table, error));
+    CHECK(table.rules.size() == 2);
+
+    stand::StandRequest heavy;
+    heavy.wtc = stand::StandWtc::H;
+    CHECK(allowed(table, heavy) == "A2 K.12");
+    heavy.schengen = true;
+    CHECK(allowed(table, heavy) == "A1 A2 B1 K.12");
+
+    stand::StandRequest medium;
+    medium.wtc = stand::StandWtc::M;
+    medium.schengen = true;
+    CHECK(allowed(table, medium) == "B1 K.12");
+}
+
+TEST_CASE(rulesPrecedence)
+{
+    // NOT binds tightest, then AND, then OR
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(build({ "A1 REQUIRE code >= E AND NOT airline = RYR OR use = P" }, table, error));
+
+    CHECK(allowed(table, request(stand::StandCode::E, "AFR")) == "A1 A2 B1 K.12");
+    CHECK(allowed(table, request(stand::StandCode::E, "RYR")) == "A2 B1 K.12");
+    CHECK(allowed(table, request(stand::StandCode::C, "AFR")) == "A2 B1 K.12");
+    CHECK(allowed(table, request(stand::StandCode::C, "RYR", stand::StandUse::generalAviation)) == "A1 A2 B1 K.12");
+
+    REQUIRE(build({ "A1 REQUIRE code >= E AND (NOT airline = RYR OR use = P)" }, table, error));
+    CHECK(allowed(table, request(stand::StandCode::C, "RYR", stand::StandUse::generalAviation)) == "A2 B1 K.12");
+    CHECK(allowed(table, request(stand::StandCode::E, "RYR", stand::StandUse::generalAviation)) == "A1 A2 B1 K.12");
+}
+
+TEST_CASE(rulesCodeComparisons)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(build({ "A1 REQUIRE code <= C", "A2 REQUIRE code = D", "B1 REQUIRE NOT code >= E" }, table, error));
+
+    CHECK(allowed(table, request(stand::StandCode::C)) == "A1 B1 K.12");
+    CHECK(allowed(table, request(stand::StandCode::D)) == "A2 B1 K.12");
+    CHECK(allowed(table, request(stand::StandCode::F)) == "K.12");
+    // An aircraft of unknown size passes no code test, NOT turns that around
+    CHECK(allowed(table, request(stand::StandCode::any)) == "B1 K.12");
+}
+
+TEST_CASE(rulesKeywordsIgnoreCase)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(build({ "A1 require Type = at43 and not National" }, table, error));
+
+    stand::StandRequest atr;
+    atr.aircraftType = stand::aircraftTypeKey("AT43");
+    CHECK(allowed(table, atr) == "A1 A2 B1 K.12");
+    atr.national = true;
+    CHECK(allowed(table, atr) == "A2 B1 K.12");
+}
+
+TEST_CASE(rulesRejectMalformedSources)
+{
+    CHECK(compiles("A1 REQUIRE schengen"));
+    CHECK(!compiles("Z9 REQUIRE schengen"));          // unknown stand
+    CHECK(!compiles("Z* REQUIRE schengen"));          // prefix matching nothing
+    CHECK(!compiles("A1 schengen"));                  // no REQUIRE
+    CHECK(!compiles("REQUIRE schengen"));             // no stand
+    CHECK(!compiles("A1 REQUIRE"));                   // no condition
+    CHECK(!compiles("A1 REQUIRE size = C"));          // unknown condition
+    CHECK(!compiles("A1 REQUIRE code > C"));          // no strict comparison
+    CHECK(!compiles("A1 REQUIRE code = G"));          // not a code letter
+    CHECK(!compiles("A1 REQUIRE use = X"));
+    CHECK(!compiles("A1 REQUIRE wtc = Q"));
+    CHECK(!compiles("A1 REQUIRE airline = RYRX"));    // airline codes are 3 letters
+    CHECK(!compiles("A1 REQUIRE type = A3200"));      // designators are up to 4
+    CHECK(!compiles("A1 REQUIRE type ="));            // missing value
+    CHECK(!compiles("A1 REQUIRE (schengen"));         // missing ')'
+    CHECK(!compiles("A1 REQUIRE schengen national")); // trailing condition
+    CHECK(!compiles("A1 REQUIRE schengen AND"));
+    CHECK(!compiles("A1 REQUIRE national.schengen"));
+
+    stand::StandTable table;
+    std::string error;
+    CHECK(!build({ "A1 REQUIRE schengen", "A1 REQUIRE nope" }, table, error));
+    CHECK(error.find("nope") != std::string::npos);
+}
+
+TEST_CASE(rulesDepthLimit)
+{
+    // Every nested OR keeps one more value on the evaluation stack
+    auto nested = [](size_t depth) {
+        std::string condition = "schengen";
+        for (size_t i = 0; i < depth; ++i) condition = "national OR (" + condition + ")";
+        return "A1 REQUIRE " + condition;
+    };
+    CHECK(compiles(nested(stand::RuleProgram::MAX_DEPTH - 1)));
+    CHECK(!compiles(nested(stand::RuleProgram::MAX_DEPTH)));
+}
+
+TEST_CASE(rulesStandTypes)
+{
+    // Resolved by stand id, so K.12 never goes through the rule lexer
+    stand::StandTable table;
+    table.icao = "TEST";
+    for (const char* name : { "A1", "A2", "B1", "K.12" }) table.addStand(name);
+    table.addType(3, "AT43");
+    table.addType(3, "at45");
+    table.addType(3, "AT42");
+    table.addType(1, "XXXX");
+    std::string error;
+    REQUIRE(table.finalize(error));
+
+    // Unknown designators are reported and dropped, a stand left without any stays open to every type
+    CHECK(table.warnings.size() == 2);
+    CHECK(table.rules.size() == 1);
+    CHECK(table.typeOffsets == std::vector<uint32_t>({ 0, 0, 0, 0, 2 }));
+
+    stand::StandRequest atr;
+    atr.aircraftType = stand::aircraftTypeKey("AT45");
+    CHECK(allowed(table, atr) == "A1 A2 B1 K.12");
+    atr.aircraftType = stand::aircraftTypeKey("AT72");
+    CHECK(allowed(table, atr) == "A1 A2 B1");
+    atr.aircraftType = 0;
+    CHECK(allowed(table, atr) == "A1 A2 B1");
+}
+
+TEST_CASE(rulesStandTypesFromConfig)
+{
+    const char* config = R"({ "STAND": {
+        "K.12": { "atyp": "AT43,AT45" },
+        "K22": { "atyp": ["AT42"] }
+    } })";
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(stand::compileStandTable(nlohmann::ordered_json::parse(config), "TEST", table, error));
+    CHECK(table.warnings.size() == 1);
+    CHECK(table.rules.size() == 1);
+    CHECK(table.types.size() == 2);
+}
@@ -0,0 +1,138 @@
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "Check.h"
+#include "core/StandOccupancy.h"
+
+namespace {
+    // W1 - W2 - W3 along the equator, 0.01 degree apart; X is off the taxiways.
+    // Each stand sits on (or, S2, next to) the node of the same number.
+    const char* CONFIG = R"({
+        "TAXI": {
+            "NODES": { "W1": "0:0", "W2": "0:0.01", "W3": "0:0.02", "X": "1:1" },
+            "TAXIWAYS": [["W1", "W2", "W3"]],
+            "EXITS": { "09": ["W1"], "27": ["W3"] }
+        },
+        "STAND": {
+            "S1": { "coordinates": "0:0" },
+            "S2": { "coordinates": "0.0001:0.01" },
+            "S3": { "coordinates": "0:0.02" },
+            "SX": { "coordinates": "1:1" },
+            "SN": {}
+        }
+    })";
+
+    bool compile(const char* config, stand::StandTable& table, std::string& error)
+    {
+        return stand::compileStandTable(nlohmann::ordered_json::parse(config), "TEST", table, error);
+    }
+
+    uint32_t meters(const char* from, const char* to)
+    {
+        const auto a = stand::parseStandPosition(from);
+        const auto b = stand::parseStandPosition(to);
+        return stand::groundMeters(a->latitude, a->longitude, b->latitude, b->longitude);
+    }
+}
+
+TEST_CASE(taxiGroundMeters)
+{
+    CHECK(meters("0:0", "0:0") == 0);
+    // 0.01 degree is about 1113 m on the equator, and the same along a meridian
+    CHECK(meters("0:0", "0:0.01") >= 1110 && meters("0:0", "0:0.01") <= 1115);
+    CHECK(meters("0:0", "0.01:0") >= 1110 && meters("0:0", "0.01:0") <= 1115);
+    CHECK(meters("0:0", "0:0.01") == meters("0:0.01", "0:0"));
+}
+
+TEST_CASE(taxiDistancesPerRunway)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(compile(CONFIG, table, error));
+    const stand::TaxiDistances& taxi = table.taxi;
+    REQUIRE(taxi.runways() == std::vector<std::string>({ "09", "27" }));
+    REQUIRE(taxi.standCount() == table.size());
+    CHECK(taxi.findRunway("27") == 1);
+    CHECK(!taxi.findRunway("18"));
+
+    const size_t rwy09 = *taxi.findRunway("09");
+    const stand::StandId s1 = *table.find("S1"), s2 = *table.find("S2"), s3 = *table.find("S3");
+    const uint32_t leg = meters("0:0", "0:0.01");
+    CHECK(taxi.meters(rwy09, s1) == 0);
+    CHECK(taxi.meters(rwy09, s2) == leg + meters("0:0.01", "0.0001:0.01")); // the node, then to the stand
+    CHECK(taxi.meters(rwy09, s3) == leg + meters("0:0.01", "0:0.02"));
+    CHECK(taxi.meters(1, s1) == taxi.meters(rwy09, s3));
+
+    // Off the graph or without position
+    CHECK(taxi.meters(rwy09, *table.find("SX")) == stand::TaxiDistances::UNREACHABLE);
+    CHECK(taxi.meters(rwy09, *table.find("SN")) == stand::TaxiDistances::UNREACHABLE);
+    CHECK(taxi.row(1)[s3] == 0);
+}
+
+TEST_CASE(taxiClosestOfActiveRunways)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(compile(CONFIG, table, error));
+    const stand::StandId s1 = *table.find("S1"), s3 = *table.find("S3");
+
+    const std::vector<uint32_t> both = table.taxi.closest({ "09", "27" });
+    REQUIRE(both.size() == table.size());
+    CHECK(both[s1] == 0);
+    CHECK(both[s3] == 0);
+    CHECK(both[*table.find("SX")] == stand::TaxiDistances::UNREACHABLE);
+
+    // Runways the graph doesn't know are skipped
+    const std::vector<uint32_t> one = table.taxi.closest({ "18", "27" });
+    REQUIRE(one.size() == table.size());
+    CHECK(one[s1] > 0);
+    CHECK(one[s3] == 0);
+    CHECK(table.taxi.closest({ "18" }).empty());
+    CHECK(table.taxi.closest({}).empty());
+}
+
+TEST_CASE(taxiConfigErrors)
+{
+    stand::StandTable table;
+    std::string error;
+    CHECK(!compile(R"({ "TAXI": { "NODES": { "W1": "0:0" }, "TAXIWAYS": [["W1", "W9"]] }, "STAND": { "S1": {} } })", table, error));
+    CHECK(error.find("W9") != std::string::npos);
+
+    table = stand::StandTable{};
+    CHECK(!compile(R"({ "TAXI": { "NODES": { "W1": "0:0" }, "EXITS": { "09": ["W9"] } }, "STAND": { "S1": {} } })", table, error));
+    table = stand::StandTable{};
+    CHECK(!compile(R"({ "TAXI": { "NODES": { "W1": "north" } }, "STAND": { "S1": {} } })", table, error));
+
+    // No TAXI section, no distances
+    table = stand::StandTable{};
+    REQUIRE(compile(R"({ "STAND": { "S1": {} } })", table, error));
+    CHECK(table.taxi.empty());
+}
+
+TEST_CASE(taxiToleranceInSelectBest)
+{
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(compile(R"({ "STAND": { "A": {}, "B": {}, "C": {}, "D": {} } })", table, error));
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+
+    // C is more than TAXI_TOLERANCE further than A, D has no taxi distance
+    const std::vector<uint32_t> taxi = { 100, 100 + stand::TAXI_TOLERANCE, 101 + stand::TAXI_TOLERANCE, stand::TaxiDistances::UNREACHABLE };
+    for (uint32_t random = 0; random < 8; ++random) {
+        const auto best = occupancy.selectBest(table.index, stand::StandRequest{}, random, nullptr, taxi.data());
+        REQUIRE(best);
+        CHECK(table.names[*best] == "A" || table.names[*best] == "B");
+    }
+
+    // Once A and B are taken the closest candidate is C
+    occupancy.occupy(*table.find("A"));
+    occupancy.occupy(*table.find("B"));
+    CHECK(occupancy.selectBest(table.index, stand::StandRequest{}, 1, nullptr, taxi.data()) == table.find("C"));
+
+    // Without any known distance every candidate stays in
+    const std::vector<uint32_t> unknown(table.size(), stand::TaxiDistances::UNREACHABLE);
+    CHECK(occupancy.selectBest(table.index, stand::StandRequest{}, 1, nullptr, unknown.data()) == table.find("D"));
+}
@@ -0,0 +1,122 @@
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "core/StandTextParser.h"
+
+namespace {
+    bool parse(std::string_view text, stand::StandTable& table, std::string& error)
+    {
+        error.clear();
+        return stand::parseStandText(text, "LFPG", table, error);
+    }
+
+    // Names of the stands id blocks, in BLOCK order
+    std::vector<std::string> blocksOf(const stand::StandTable& table, stand::StandId id)
+    {
+        std::vector<std::string> names;
+        for (uint32_t i = table.blockOffsets[id]; i < table.blockOffsets[id + 1]; ++i) names.push_back(table.names[table.blocks[i]]);
+        return names;
+    }
+
+    std::vector<std::string> airlinesOf(const stand::StandTable& table, stand::StandId id)
+    {
+        return { table.airlines.begin() + table.airlineOffsets[id], table.airlines.begin() + table.airlineOffsets[id + 1] };
+    }
+}
+
+TEST_CASE(textParserStands)
+{
+    const char* text =
+        "; exported stands\r\n"
+        "STAND:LFPG:A01:N049.00.59.410:E002.33.38.560:25\r\n"
+        "USE:A\n"
+        "NON-SCHENGEN\n"
+        "CALLSIGN:afr, DAH\n"
+        "CODE:E\n"
+        "WTC:H\n"
+        "PRIORITY:+1\n"
+        "BLOCK:A02\n"
+        "\n"
+        "STAND:LFPO:A01:48.7:2.3\n"
+        "USE:H\n"
+        "   STAND:LFPG:A02\n"
+        "  NATIONAL\n"
+        "UNKNOWN:ignored\n"
+        "// alternate position, the first definition wins\n"
+        "STAND:LFPG:A01:49.0:2.5\n"
+        "USE:P\n";
+
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(parse(text, table, error));
+    CHECK(table.icao == "LFPG");
+    REQUIRE(table.size() == 2);
+
+    const stand::StandId a01 = *table.find("A01");
+    CHECK(table.use[a01] == stand::StandUse::airliner); // neither LFPO's USE nor the duplicate's
+    CHECK(table.code[a01] == stand::StandCode::E);
+    CHECK(table.wtc[a01] == stand::StandWtc::H);
+    CHECK(table.priority[a01] == 1);
+    CHECK(table.flags[a01] == (stand::StandFlag::hasSchengen | stand::StandFlag::hasPosition));
+    CHECK(table.latitude[a01] == 490165028);
+    CHECK(table.radius[a01] == 25);
+    CHECK(airlinesOf(table, a01) == std::vector<std::string>({ "AFR", "DAH" }));
+    CHECK(blocksOf(table, a01) == std::vector<std::string>({ "A02" }));
+
+    const stand::StandId a02 = *table.find("A02");
+    CHECK(table.use[a02] == stand::StandUse::any);
+    CHECK(table.flags[a02] == (stand::StandFlag::hasNational | stand::StandFlag::national));
+    CHECK(blocksOf(table, a02).empty());
+}
+
+TEST_CASE(textParserAirportLines)
+{
+    const char* text =
+        "RELAX:LFPO:USE\n"
+        "RELAX:LFPG:SCHENGEN,wtc\n"
+        "RULE:LFPG:A01 REQUIRE code >= E\n"
+        "RULE:LFPO:A01 REQUIRE nope\n"
+        "STAND:LFPG:A01\n"
+        "STAND:LFPG:A02\n";
+
+    stand::StandTable table;
+    std::string error;
+    REQUIRE(parse(text, table, error));
+    CHECK(table.relaxations == std::vector<stand::Relaxation>({ stand::Relaxation::schengen, stand::Relaxation::wtc }));
+    CHECK(table.ruleSources == std::vector<std::string>({ "A01 REQUIRE code >= E" }));
+    CHECK(table.rules.size() == 1);
+}
+
+TEST_CASE(textParserErrors)
+{
+    stand::StandTable table;
+    std::string error;
+
+    CHECK(!parse("STAND:LFPG:A01\nUSE:X\n", table, error));
+    CHECK(error.starts_with("line 2:"));
+    CHECK(!parse("STAND:LFPG:A01\nCODE:G\n", table, error));
+    CHECK(!parse("STAND:LFPG:A01\nWTC:Q\n", table, error));
+    CHECK(!parse("STAND:LFPG:A01\nPRIORITY:256\n", table, error));
+    CHECK(!parse("STAND:LFPG:A01\nPRIORITY:1x\n", table, error));
+    CHECK(!parse("STAND:LFPG:A01:N049.00.59:E002.33\n", table, error));
+    CHECK(!parse("STAND:LFPG:\n", table, error));
+    CHECK(!parse("RELAX:LFPG:USE,USE\nSTAND:LFPG:A01\n", table, error));
+    CHECK(!parse("STAND:LFPG:A01\nBLOCK:Z99\n", table, error)); // checked by finalize
+
+    // Nothing for this airport
+    CHECK(!parse("STAND:LFPO:A01\n", table, error));
+    CHECK(error == "No STAND for LFPG in config");
+
+    // Lines of a skipped stand are never read
+    CHECK(parse("STAND:LFPO:A01\nUSE:X\nSTAND:LFPG:A01\n", table, error));
+}
+
+TEST_CASE(textFormatDetection)
+{
+    CHECK(stand::isStandTextFormat("STAND:LFPG:A01"));
+    CHECK(stand::isStandTextFormat("\xEF\xBB\xBF; comment\nSTAND:LFPG:A01"));
+    CHECK(!stand::isStandTextFormat("  \r\n{ \"STAND\": {} }"));
+    CHECK(!stand::isStandTextFormat("\xEF\xBB\xBF{}"));
+    CHECK(!stand::isStandTextFormat(" \n\t"));
+}
@@ -0,0 +1,127 @@
+#include "Check.h"
+#include "core/StandTimeline.h"
+
+namespace {
+    stand::StandBitset bits(size_t size, std::initializer_list<size_t> set)
+    {
+        stand::StandBitset result(size);
+        for (size_t id : set) result.set(id);
+        return result;
+    }
+
+    bool same(const stand::StandBitset& a, const stand::StandBitset& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t id = 0; id < a.size(); ++id) {
+            if (a.test(id) != b.test(id)) return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE(timelineEmptyStandsAreFree)
+{
+    stand::StandTimeline timeline;
+    timeline.reset(3);
+    stand::StandBitset free;
+    timeline.freeDuring(bits(3, { 0, 2 }), 0, 3600, free);
+    CHECK(same(free, bits(3, { 0, 2 })));
+}
+
+TEST_CASE(timelineWindowBounds)
+{
+    // Reservations end exclusive: back to back windows don't overlap
+    stand::StandTimeline timeline;
+    timeline.reset(1);
+    timeline.reserve(0, 100, 200, 1);
+
+    CHECK(timeline.isFree(0, 0, 100));
+    CHECK(timeline.isFree(0, 200, 300));
+    CHECK(!timeline.isFree(0, 0, 101));
+    CHECK(!timeline.isFree(0, 199, 300));
+    CHECK(!timeline.isFree(0, 150, 160));
+    CHECK(!timeline.isFree(0, 0, 1000));
+}
+
+TEST_CASE(timelineLongReservationHidesBehindLaterOnes)
+{
+    // A long block starting first still covers a window after a short occupation ends
+    stand::StandTimeline timeline;
+    timeline.reset(1);
+    timeline.reserve(0, 500, 600, 2);
+    timeline.reserve(0, 0, 1000, 1);
+    timeline.reserve(0, 2000, 2100, 3);
+
+    CHECK(!timeline.isFree(0, 700, 800));
+    CHECK(timeline.isFree(0, 1000, 2000));
+    CHECK(!timeline.isFree(0, 1500, 2050));
+    CHECK(timeline.reservations(0).front().holder == 1);
+
+    timeline.release(0, 1);
+    CHECK(timeline.isFree(0, 700, 800));
+    CHECK(!timeline.isFree(0, 550, 800));
+}
+
+TEST_CASE(timelineReleaseAndExtend)
+{
+    stand::StandTimeline timeline;
+    timeline.reset(2);
+    timeline.reserve(0, 100, 200, 7);
+    timeline.reserve(1, 100, 200, 7);
+    timeline.reserve(0, 300, 400, 8);
+
+    timeline.extend(0, 7, 350);
+    CHECK(!timeline.isFree(0, 250, 280));
+    timeline.extend(0, 7, 120); // never shortens
+    CHECK(!timeline.isFree(0, 250, 280));
+
+    timeline.release(0, 7);
+    CHECK(timeline.isFree(0, 100, 300));
+    CHECK(!timeline.isFree(0, 350, 360));
+    CHECK(!timeline.isFree(1, 100, 200)); // other stands keep their holder
+
+    timeline.release(0, 99); // unknown holder
+    CHECK(timeline.reservations(0).size() == 1);
+}
+
+TEST_CASE(timelineHoldersStarting)
+{
+    stand::StandTimeline timeline;
+    timeline.reset(1);
+    timeline.reserve(0, 0, 1000, 1);
+    timeline.reserve(0, 1200, 1300, 2);
+    timeline.reserve(0, 1500, 1600, 3);
+    timeline.reserve(0, 2000, 2100, 4);
+
+    // Only the reservations starting in the window, not the one reaching into it
+    std::vector<uint32_t> holders;
+    timeline.holdersStarting(0, 500, 1500, holders);
+    CHECK(holders == std::vector<uint32_t>({ 2 }));
+    timeline.holdersStarting(0, 1000, 2001, holders);
+    CHECK(holders == std::vector<uint32_t>({ 2, 2, 3, 4 }));
+}
+
+TEST_CASE(timelineFreeDuring)
+{
+    stand::StandTimeline timeline;
+    timeline.reset(4);
+    timeline.reserve(0, 0, 1000, 1);
+    timeline.reserve(1, 0, 100, 2);
+    timeline.reserve(2, 900, 1000, 3);
+
+    // Only held stands are reported, the output is cleared first
+    stand::StandBitset free = bits(4, { 0, 1, 2, 3 });
+    timeline.freeDuring(bits(4, { 0, 1, 2 }), 100, 900, free);
+    CHECK(same(free, bits(4, { 1, 2 })));
+
+    timeline.freeDuring(bits(4, { 0, 1, 2 }), 50, 950, free);
+    CHECK(same(free, bits(4, {})));
+
+    timeline.freeDuring(bits(4, {}), 100, 900, free);
+    CHECK(same(free, bits(4, {})));
+
+    // Held stands the timeline doesn't know (table grew) are left out
+    timeline.reset(2);
+    timeline.freeDuring(bits(4, { 1, 3 }), 0, 10, free);
+    CHECK(same(free, bits(4, { 1 })));
+}
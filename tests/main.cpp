@@ -0,0 +1,43 @@
+#include <iostream>
+#include <string_view>
+
+#include "Check.h"
+
+namespace {
+    size_t failures = 0;
+}
+
+namespace test {
+    std::vector<Case>& cases()
+    {
+        static std::vector<Case> registered;
+        return registered;
+    }
+
+    void fail(const char* file, int line, const std::string& expression)
+    {
+        ++failures;
+        std::cerr << file << ":" << line << ": check failed: " << expression << "\n";
+    }
+}
+
+// neostand-tests [name filter]: runs every case whose name contains the filter,
+// a filter matching no case fails so a typo doesn't pass silently
+int main(int argc, char** argv)
+{
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+    size_t run = 0;
+    size_t failed = 0;
+    for (const test::Case& testCase : test::cases()) {
+        if (std::string_view(testCase.name).find(filter) == std::string_view::npos) continue;
+        const size_t before = failures;
+        testCase.run();
+        ++run;
+        if (failures != before) {
+            ++failed;
+            std::cerr << "FAILED " << testCase.name << "\n";
+        }
+    }
+    std::cout << run - failed << "/" << run << " test cases passed\n";
+    return failed == 0 && (run != 0 || filter.empty()) ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+// neostand-bench: measures stand candidate computation on a real airport config.
+//
+// Usage: neostand-bench <config file> [-n <iterations>] [-o <occupied percent>] [-b <batch size>] [-s <seed>]
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "core/CandidateCache.h"
+#include "core/StandIndex.h"
+#include "core/StandMatcher.h"
+#include "core/StandOccupancy.h"
+#include "core/StandRandom.h"
+#include "core/StandTable.h"
+#include "core/StandTextParser.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Options {
+    fs::path config;
+    size_t iterations = 1000000;
+    unsigned int occupiedPercent = 30;
+    size_t batchSize = 120;
+    uint64_t seed = 42;
+};
+
+bool parseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) {
+            options.iterations = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-b" && i + 1 < argc) {
+            options.batchSize = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-s" && i + 1 < argc) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "-o" && i + 1 < argc) {
+            options.occupiedPercent = static_cast<unsigned int>(std::atoi(argv[++i]));
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        }
+        else {
+            options.config = arg;
+        }
+    }
+    return !options.config.empty() && options.iterations > 0;
+}
+
+bool loadConfig(const fs::path& path, stand::StandTable& table, std::string& error)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        error = "Could not open " + path.string();
+        return false;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    const std::string icao = path.stem().string();
+    try {
+        return stand::isStandTextFormat(content)
+            ? stand::parseStandText(content, icao, table, error)
+            : stand::compileStandTable(nlohmann::ordered_json::parse(content), icao, table, error);
+    }
+    catch (const std::exception& e) {
+        error = e.what();
+        return false;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: neostand-bench <config file> [-n <iterations>] [-o <occupied percent>] [-b <batch size>] [-s <seed>]\n";
+        return 2;
+    }
+
+    stand::StandTable table;
+    std::string error;
+    if (!loadConfig(options.config, table, error)) {
+        std::cerr << "error: " << error << "\n";
+        return 1;
+    }
+
+    // Fixed seed so runs are comparable
+    stand::StandRandom rng(options.seed);
+    stand::StandBitset occupied(table.size());
+    stand::StandBitset blocked(table.size());
+    for (size_t id = 0; id < table.size(); ++id) {
+        if (rng() % 100 < options.occupiedPercent) occupied.set(id);
+        if (rng() % 100 < options.occupiedPercent / 3) blocked.set(id);
+    }
+
+    // Every attribute combination a pilot can present, cycled through
+    std::vector<stand::StandRequest> requests;
+    for (uint8_t use = 0; use <= static_cast<uint8_t>(stand::StandUse::cargo); ++use) {
+        for (uint8_t wtc = 0; wtc <= static_cast<uint8_t>(stand::StandWtc::J); ++wtc) {
+            for (int flags = 0; flags < 4; ++flags) {
+                stand::StandRequest request;
+                request.use = static_cast<stand::StandUse>(use);
+                request.wtc = static_cast<stand::StandWtc>(wtc);
+                request.schengen = flags & 1;
+                request.national = flags & 2;
+                requests.push_back(request);
+            }
+        }
+    }
+
+    stand::StandBitset candidates(table.size());
+    size_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < options.iterations; ++i) {
+        table.index.candidates(requests[i % requests.size()], occupied, blocked, candidates);
+        checksum += candidates.count();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << table.icao << ": " << table.size() << " stands, " << candidates.wordCount() << " words per bitmap\n"
+              << "candidate set + count: " << elapsed / options.iterations << " ns/pilot over "
+              << options.iterations << " iterations (checksum " << checksum << ")\n";
+
+    // Same requests with a CALLSIGN preference, through the per-profile cache
+    stand::CandidateCache cache;
+    const uint32_t airline = table.index.byAirline.empty() ? 0 : table.index.byAirline.begin()->first;
+    checksum = 0;
+    const auto cachedStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < options.iterations; ++i) {
+        stand::StandRequest request = requests[i % requests.size()];
+        request.airline = airline;
+        stand::liveCandidates(table.index, cache.profile(table, request), occupied, blocked, candidates);
+        checksum += candidates.count();
+    }
+    const auto cachedElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - cachedStart).count();
+    std::cout << "memoised profile + airline + count: " << cachedElapsed / options.iterations << " ns/pilot, "
+              << cache.size() << " profiles, " << cache.hits() << " hits (checksum " << checksum << ")\n";
+
+    // One tick worth of simultaneous arrivals on an empty airport, solved as a single matching
+    stand::StandOccupancy occupancy;
+    occupancy.reset(table);
+    std::vector<stand::StandRequest> batch;
+    for (size_t i = 0; i < options.batchSize; ++i) {
+        stand::StandRequest request = requests[rng() % requests.size()];
+        request.use = stand::StandUse::airliner;
+        request.code = static_cast<stand::StandCode>(3 + rng() % 4); // C to F
+        batch.push_back(request);
+    }
+
+    const auto batchStart = std::chrono::steady_clock::now();
+    const std::vector<std::optional<stand::StandId>> matched = stand::matchStands(table, occupancy, batch);
+    const auto batchElapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - batchStart).count();
+
+    size_t assigned = 0;
+    for (const auto& stand : matched) assigned += stand.has_value();
+    std::cout << "batch matching: " << assigned << "/" << batch.size() << " pilots assigned in " << batchElapsed << " us\n";
+
+    // Same arrivals one at a time, the way the plugin assigns them: the checksum only
+    // changes with the seed, the config or the selection logic
+    stand::StandRandom selection(stand::StandRandom::airportSeed(options.seed, table.icao));
+    size_t sequenceChecksum = 0;
+    assigned = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const std::optional<stand::StandId> selected = occupancy.selectBest(table.index, batch[i], selection.next());
+        if (!selected) continue;
+        occupancy.hold(*selected);
+        sequenceChecksum = sequenceChecksum * 31 + *selected + 1;
+        ++assigned;
+    }
+    std::cout << "sequential selection: " << assigned << "/" << batch.size() << " pilots assigned (seed " << options.seed
+              << ", checksum " << sequenceChecksum << ")\n";
+
+    // The plugin always hands over a released set, mostly empty: it must select like no set at all,
+    // and a released stand must still be found once every stand of its priority level is held
+    stand::StandOccupancy empty;
+    empty.reset(table);
+    stand::StandOccupancy full;
+    full.reset(table);
+    for (size_t id = 0; id < table.size(); ++id) full.hold(static_cast<stand::StandId>(id));
+
+    stand::StandBitset noneReleased(table.size());
+    size_t releasedChecks = 0;
+    for (const stand::StandRequest& request : batch) {
+        const uint32_t random = selection.next();
+        const std::optional<stand::StandId> expected = occupancy.selectBest(table.index, request, random);
+        if (occupancy.selectBest(table.index, request, random, &noneReleased) != expected) {
+            std::cerr << "error: selection changed with an empty released set\n";
+            return 1;
+        }
+
+        const std::optional<stand::StandId> target = empty.selectBest(table.index, request, random);
+        if (!target) continue;
+        stand::StandBitset released(table.size());
+        released.set(*target);
+        if (full.selectBest(table.index, request, random, &noneReleased) || full.selectBest(table.index, request, random, &released) != target) {
+            std::cerr << "error: released stand " << table.names[*target] << " not selected on a full airport\n";
+            return 1;
+        }
+        ++releasedChecks;
+    }
+    std::cout << "released set checks: " << releasedChecks << " passed\n";
+    return 0;
+}
@@ -0,0 +1,242 @@
+// neostand-compile: turns NeoSTAND airport configs (JSON or STAND: text exports)
+// into the binary <ICAO>.nsdb databases loaded by the plugin, or into a single
+// multi-airport stands.nsbundle.
+//
+// Usage: neostand-compile <file|directory>... [-o <output dir>] [-j <threads>] [-b <bundle>] [-d]
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "core/StandBundle.h"
+#include "core/StandDatabase.h"
+#include "core/StandTable.h"
+#include "core/StandTextParser.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Options {
+    std::vector<fs::path> inputs;
+    fs::path outputDir;
+    fs::path bundle;
+    bool dumpRules = false;
+    unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+};
+
+void printUsage()
+{
+    std::cerr << "Usage: neostand-compile <file|directory>... [-o <output dir>] [-j <threads>] [-b <bundle>] [-d]\n"
+              << "  Compiles <ICAO>.json configs (JSON or STAND: text format) into <ICAO>.nsdb\n"
+              << "  -o  output directory (default: next to each input)\n"
+              << "  -j  worker threads (default: hardware concurrency)\n"
+              << "  -b  write every airport into one bundle file instead (e.g. " << stand::bundle::FILE_NAME << ")\n"
+              << "  -d  print the compiled RULES bytecode, RELAX ladder and TAXI distances of each airport\n";
+}
+
+bool parseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            return false;
+        }
+        else if (arg == "-o" && i + 1 < argc) {
+            options.outputDir = argv[++i];
+        }
+        else if (arg == "-b" && i + 1 < argc) {
+            options.bundle = argv[++i];
+        }
+        else if (arg == "-d") {
+            options.dumpRules = true;
+        }
+        else if (arg == "-j" && i + 1 < argc) {
+            options.threads = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "Unknown option: " << arg << "\n";
+            return false;
+        }
+        else {
+            options.inputs.emplace_back(arg);
+        }
+    }
+    return !options.inputs.empty();
+}
+
+std::vector<fs::path> collectConfigs(const std::vector<fs::path>& inputs)
+{
+    std::vector<fs::path> configs;
+    for (const auto& input : inputs) {
+        if (fs::is_directory(input)) {
+            for (const auto& entry : fs::directory_iterator(input)) {
+                if (entry.is_regular_file() && (entry.path().extension() == ".json" || entry.path().extension() == ".txt"))
+                    configs.push_back(entry.path());
+            }
+        }
+        else {
+            configs.push_back(input);
+        }
+    }
+    std::sort(configs.begin(), configs.end());
+    return configs;
+}
+
+bool compileConfig(const fs::path& input, stand::StandTable& table, std::string& message)
+{
+    const std::string icao = input.stem().string();
+
+    std::ifstream file(input, std::ios::binary);
+    if (!file.is_open()) {
+        message = "Could not open " + input.string();
+        return false;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::string error;
+    try {
+        bool parsed = stand::isStandTextFormat(content)
+            ? stand::parseStandText(content, icao, table, error)
+            : stand::compileStandTable(nlohmann::ordered_json::parse(content), icao, table, error);
+        if (!parsed) {
+            message = input.string() + ": " + error;
+            return false;
+        }
+    }
+    catch (const std::exception& e) {
+        message = input.string() + ": " + e.what();
+        return false;
+    }
+    return true;
+}
+
+bool writeDatabase(const fs::path& input, const fs::path& outputDir, const stand::StandTable& table, std::string& message)
+{
+    const std::string icao = input.stem().string();
+    std::string error;
+
+    fs::path output = (outputDir.empty() ? input.parent_path() : outputDir) / (icao + stand::db::FILE_EXTENSION);
+    if (!stand::writeStandDatabase(table, output, error)) {
+        message = error;
+        return false;
+    }
+
+    message = icao + ": " + std::to_string(table.size()) + " stands -> " + output.string();
+    return true;
+}
+
+std::string dumpRules(const stand::StandTable& table)
+{
+    std::string out = "RELAX:";
+    for (stand::Relaxation rung : table.relaxations) {
+        out += std::string(" ") + stand::toString(rung);
+    }
+    if (table.relaxations.empty()) out += " none";
+    out += "\n";
+    out += table.rules.empty() ? "no RULES" : table.rules.dump();
+    if (out.back() != '\n') out += "\n";
+
+    // Per runway: stands reached and the closest / farthest of them
+    if (table.taxi.empty()) out += "no TAXI";
+    for (size_t runway = 0; runway < table.taxi.runways().size(); ++runway) {
+        size_t reached = 0;
+        size_t closest = 0;
+        size_t farthest = 0;
+        for (size_t id = 0; id < table.size(); ++id) {
+            const uint32_t meters = table.taxi.meters(runway, static_cast<stand::StandId>(id));
+            if (meters == stand::TaxiDistances::UNREACHABLE) continue;
+            if (reached == 0 || meters < table.taxi.meters(runway, static_cast<stand::StandId>(closest))) closest = id;
+            if (reached == 0 || meters > table.taxi.meters(runway, static_cast<stand::StandId>(farthest))) farthest = id;
+            ++reached;
+        }
+        out += "TAXI " + table.taxi.runways()[runway] + ": " + std::to_string(reached) + "/" + std::to_string(table.size()) + " stands reached";
+        if (reached > 0) {
+            out += ", closest " + table.names[closest] + " " + std::to_string(table.taxi.meters(runway, static_cast<stand::StandId>(closest))) + " m"
+                + ", farthest " + table.names[farthest] + " " + std::to_string(table.taxi.meters(runway, static_cast<stand::StandId>(farthest))) + " m";
+        }
+        out += "\n";
+    }
+    if (out.back() == '\n') out.pop_back();
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    if (!options.outputDir.empty()) {
+        std::error_code ec;
+        fs::create_directories(options.outputDir, ec);
+        if (ec) {
+            std::cerr << "Could not create output directory " << options.outputDir.string() << "\n";
+            return 1;
+        }
+    }
+
+    const std::vector<fs::path> configs = collectConfigs(options.inputs);
+    std::vector<stand::StandTable> tables(configs.size());
+    std::atomic<size_t> next = 0;
+    std::atomic<size_t> failures = 0;
+    std::mutex outputMutex;
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < configs.size(); i = next++) {
+            std::string message;
+            bool ok = compileConfig(configs[i], tables[i], message);
+            if (ok && options.bundle.empty()) {
+                ok = writeDatabase(configs[i], options.outputDir, tables[i], message);
+            }
+            else if (ok) {
+                message = tables[i].icao + ": " + std::to_string(tables[i].size()) + " stands";
+            }
+            if (!ok) ++failures;
+            if (ok && options.dumpRules) {
+                message += '\n';
+                message += dumpRules(tables[i]);
+            }
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            for (const std::string& warning : tables[i].warnings) {
+                std::cerr << "warning: " << warning << "\n";
+            }
+            (ok ? std::cout : std::cerr) << (ok ? "" : "error: ") << message << "\n";
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const unsigned int threadCount = std::min<unsigned int>(options.threads, static_cast<unsigned int>(std::max<size_t>(1, configs.size())));
+    for (unsigned int t = 0; t < threadCount; ++t) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    std::cout << configs.size() - failures << "/" << configs.size() << " configs compiled\n";
+    if (failures != 0) return 1;
+
+    if (!options.bundle.empty()) {
+        fs::path output = options.outputDir.empty() ? options.bundle : options.outputDir / options.bundle.filename();
+        std::string error;
+        if (!stand::writeStandBundle(tables, output, error)) {
+            std::cerr << "error: " << error << "\n";
+            return 1;
+        }
+        std::cout << tables.size() << " airports -> " << output.string() << "\n";
+    }
+    return 0;
+}